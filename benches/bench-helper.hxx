@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <print>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CXX_BENCHES_PERF_EVENT 1
+#endif
+
+namespace cxx_benches
+{
+    using namespace std::string_view_literals;
+
+    /// @brief The number of operations performed by one call to a benchmark function
+    constexpr inline std::size_t batch_size{4096};
+
+    /// @brief Prevents the compiler from discarding the computation of `_val`
+    template <typename T>
+    void do_not_optimize(const T &_val) noexcept
+    {
+        asm volatile("" : : "r,m"(_val) : "memory");
+    }
+
+    /// @brief Counts the user-space instructions retired by this thread, using `perf_event_open` where it is available and permitted
+    struct instruction_counter
+    {
+    private:
+        int _m_fd{-1};
+
+    public:
+        instruction_counter() noexcept
+        {
+#ifdef CXX_BENCHES_PERF_EVENT
+            perf_event_attr _attr{};
+            _attr.type = PERF_TYPE_HARDWARE;
+            _attr.size = sizeof(_attr);
+            _attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            _attr.disabled = 1;
+            _attr.exclude_kernel = 1;
+            _attr.exclude_hv = 1;
+            this->_m_fd = static_cast<int>(::syscall(SYS_perf_event_open, &_attr, 0, -1, -1, 0));
+#endif
+        }
+
+        instruction_counter(const instruction_counter &) = delete;
+        instruction_counter &operator=(const instruction_counter &) = delete;
+
+        ~instruction_counter()
+        {
+#ifdef CXX_BENCHES_PERF_EVENT
+            if (this->_m_fd >= 0)
+                ::close(this->_m_fd);
+#endif
+        }
+
+        bool available() const noexcept
+        {
+            return this->_m_fd >= 0;
+        }
+
+        void start() noexcept
+        {
+#ifdef CXX_BENCHES_PERF_EVENT
+            if (this->available())
+            {
+                ::ioctl(this->_m_fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(this->_m_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        std::optional<std::uint64_t> stop() noexcept
+        {
+#ifdef CXX_BENCHES_PERF_EVENT
+            std::uint64_t _count{};
+            if (this->available() && ::ioctl(this->_m_fd, PERF_EVENT_IOC_DISABLE, 0) == 0 && ::read(this->_m_fd, &_count, sizeof(_count)) == sizeof(_count))
+                return _count;
+#endif
+            return std::nullopt;
+        }
+    };
+
+    /// @brief Returns `_n` values drawn from `_keys`, so that every benchmark of a group sees the same sequence
+    template <typename T>
+    std::vector<T> sample(std::span<const T> _keys, std::size_t _n = batch_size, std::uint64_t _seed = 0x5eed)
+    {
+        std::mt19937_64 _rng{_seed};
+        std::uniform_int_distribution<std::size_t> _pick{0, _keys.size() - 1};
+        std::vector<T> _vals;
+        _vals.reserve(_n);
+        for (std::size_t _i = 0; _i < _n; _i++)
+            _vals.push_back(_keys[_pick(_rng)]);
+        return _vals;
+    }
+
+    /// @brief A benchmark: `_m_func` performs `batch_size` operations, and returns a value that depends on all of them
+    struct bench
+    {
+        std::uint64_t (*_m_func)();
+        std::string_view _m_bench_name;
+
+        bench(std::uint64_t (*_func)(), std::string_view _bench_name) : _m_func(_func), _m_bench_name(_bench_name) {}
+
+        /// @brief Runs the benchmark for at least `_min_time` per sample, and prints the best of `_samples` samples
+        void operator()(instruction_counter &_counter, std::chrono::nanoseconds _min_time = std::chrono::milliseconds{20}, std::size_t _samples = 5) const
+        {
+            using _clock = std::chrono::steady_clock;
+
+            // Warm up, and find a number of batches that takes at least _min_time
+            std::size_t _batches{1};
+            while (true)
+            {
+                auto _start{_clock::now()};
+                for (std::size_t _i = 0; _i < _batches; _i++)
+                    do_not_optimize(this->_m_func());
+                if (_clock::now() - _start >= _min_time)
+                    break;
+                _batches *= 2;
+            }
+
+            double _best_ns{std::numeric_limits<double>::infinity()};
+            std::optional<double> _best_insns;
+            for (std::size_t _s = 0; _s < _samples; _s++)
+            {
+                _counter.start();
+                auto _start{_clock::now()};
+                for (std::size_t _i = 0; _i < _batches; _i++)
+                    do_not_optimize(this->_m_func());
+                auto _elapsed{_clock::now() - _start};
+                auto _insns{_counter.stop()};
+
+                const double _ops{static_cast<double>(_batches * batch_size)};
+                _best_ns = std::min(_best_ns, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(_elapsed).count()) / _ops);
+                if (_insns)
+                    _best_insns = std::min(_best_insns.value_or(std::numeric_limits<double>::infinity()), static_cast<double>(*_insns) / _ops);
+            }
+
+            if (_best_insns)
+                std::println("{:<40} {:>10.2f} ns/op {:>10.1f} insns/op"sv, this->_m_bench_name, _best_ns, *_best_insns);
+            else
+                std::println("{:<40} {:>10.2f} ns/op {:>10} insns/op"sv, this->_m_bench_name, _best_ns, "-"sv);
+        }
+    };
+
+    /// @brief Runs each benchmark whose name contains one of the strings in `_filters`, or every benchmark if there are none
+    template <typename ArgsView, typename... Benches>
+    void _bench_driver_impl(ArgsView &&_args, Benches &&..._benches)
+    {
+        std::vector<std::string_view> _filters;
+        for (std::string_view _arg : _args | std::views::drop(1))
+            _filters.push_back(_arg);
+
+        instruction_counter _counter;
+        if (!_counter.available())
+            std::println(std::cerr, "perf_event instruction counter unavailable; reporting time only"sv);
+
+        auto _selected = [&](const bench &_bench)
+        {
+            return _filters.empty() || std::ranges::any_of(_filters, [&](std::string_view _filter)
+                                                           { return _bench._m_bench_name.find(_filter) != std::string_view::npos; });
+        };
+
+        ((_selected(_benches) ? _benches(_counter) : void()), ...);
+    }
+}
+
+#define make_bench(_bench) \
+    bench { _bench, std::string_view(#_bench) }
+
+#define BENCH_DRIVER(...)                                                                                                                        \
+    int main(int argc, char **argv)                                                                                                              \
+    {                                                                                                                                            \
+        std::span<char *> args{argv, static_cast<std::size_t>(argc)};                                                                            \
+        cxx_benches::_bench_driver_impl(args | std::views::transform([](auto &&a) { return std::string_view{a}; }) __VA_OPT__(, __VA_ARGS__)); \
+    }
@@ -0,0 +1,71 @@
+#include <match.hxx>
+
+#include "bench-helper.hxx"
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+// Each benchmark reads every field of its input once, either through `binding` patterns or directly, to show that binding adds no work.
+
+const std::vector<int> &scalars()
+{
+    static const std::vector<int> _inputs{[]
+                                          {
+                                              std::vector<int> _keys;
+                                              for (int _i = 0; _i < 1024; _i++)
+                                                  _keys.push_back(_i * 7 - 100);
+                                              return cxx_benches::sample<int>(_keys);
+                                          }()};
+    return _inputs;
+}
+
+const std::vector<std::tuple<int, long, short>> &records()
+{
+    static const std::vector<std::tuple<int, long, short>> _inputs{[]
+                                                                  {
+                                                                      std::vector<std::tuple<int, long, short>> _keys;
+                                                                      for (int _i = 0; _i < 1024; _i++)
+                                                                          _keys.emplace_back(_i, _i * 3L, static_cast<short>(-_i));
+                                                                      return cxx_benches::sample<std::tuple<int, long, short>>(_keys);
+                                                                  }()};
+    return _inputs;
+}
+
+std::uint64_t scalar_binding()
+{
+    std::uint64_t _sum{};
+    for (const int &_val : scalars())
+        _sum += static_cast<std::uint64_t>(cxx_patterns::match(_val, cxx_patterns::match_arm{cxx_patterns::binding{}, [](const int &_x)
+                                                                                              { return _x * 3; }}));
+    return _sum;
+}
+
+std::uint64_t scalar_direct()
+{
+    std::uint64_t _sum{};
+    for (const int &_val : scalars())
+        _sum += static_cast<std::uint64_t>(_val * 3);
+    return _sum;
+}
+
+std::uint64_t tuple_binding()
+{
+    std::uint64_t _sum{};
+    for (const auto &_val : records())
+        _sum += static_cast<std::uint64_t>(cxx_patterns::match(_val, cxx_patterns::match_arm{std::tuple{cxx_patterns::binding{}, cxx_patterns::binding{}, cxx_patterns::binding{}},
+                                                                                              [](const int &_a, const long &_b, const short &_c)
+                                                                                              { return _a + _b * 2 + _c; }}));
+    return _sum;
+}
+
+std::uint64_t tuple_direct()
+{
+    std::uint64_t _sum{};
+    for (const auto &_val : records())
+        _sum += static_cast<std::uint64_t>(std::get<0>(_val) + std::get<1>(_val) * 2 + std::get<2>(_val));
+    return _sum;
+}
+
+BENCH_DRIVER(cxx_benches::make_bench(scalar_binding), cxx_benches::make_bench(scalar_direct),
+             cxx_benches::make_bench(tuple_binding), cxx_benches::make_bench(tuple_direct));
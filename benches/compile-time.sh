@@ -0,0 +1,91 @@
+#!/bin/sh
+# Measures how long each compiler takes, and how much memory it uses, to compile a synthetic `match` with many arms.
+#
+# usage: compile-time.sh [arm-count...]                   (default: 16 64 256 1024)
+#
+# Environment:
+#   COMPILERS   compilers to time, skipping any that are not installed (default: "g++ clang++")
+#   KINDS       which arms to generate (default: "integral linear string"):
+#                 integral - `constant` arms, dispatched through an interval table
+#                 linear   - plain integer arms, tested in turn
+#                 string   - `string_constant` arms, dispatched through a perfect hash
+#   CPPFLAGS    preprocessor flags (default: -Iinclude/)
+#   CXXFLAGS    compiler flags (default: -std=c++23 -O2)
+#   OUT         directory for the generated sources (default: out/compile-time)
+
+ARMS=${*:-16 64 256 1024}
+COMPILERS=${COMPILERS:-g++ clang++}
+KINDS=${KINDS:-integral linear string}
+CPPFLAGS=${CPPFLAGS:--Iinclude/}
+CXXFLAGS=${CXXFLAGS:--std=c++23 -O2}
+OUT=${OUT:-out/compile-time}
+
+mkdir -p "$OUT"
+
+generate() {
+    kind=$1
+    arms=$2
+
+    echo '#include <match.hxx>'
+    echo '#include <string_view>'
+    echo
+    if [ "$kind" = string ]; then
+        echo 'int dispatch(std::string_view _val)'
+    else
+        echo 'int dispatch(int _val)'
+    fi
+    echo '{'
+    echo '    return cxx_patterns::match(_val,'
+    i=0
+    while [ "$i" -lt "$arms" ]; do
+        case $kind in
+        integral) echo "        cxx_patterns::match_arm{cxx_patterns::constant<$((i * 3))>{}, [] { return $i; }}," ;;
+        linear) echo "        cxx_patterns::match_arm{$((i * 3)), [] { return $i; }}," ;;
+        string) echo "        cxx_patterns::match_arm{cxx_patterns::string_constant<\"key_$i\">{}, [] { return $i; }}," ;;
+        esac
+        i=$((i + 1))
+    done
+    echo '        cxx_patterns::match_arm{cxx_patterns::binding{}, [](const auto &) { return -1; }});'
+    echo '}'
+}
+
+now() {
+    date +%s.%N
+}
+
+printf '%-12s %-9s %6s %10s %12s\n' compiler kind arms seconds "max RSS MiB"
+
+for cxx in $COMPILERS; do
+    if ! command -v "$cxx" >/dev/null 2>&1; then
+        echo "$cxx: not found, skipping" >&2
+        continue
+    fi
+
+    for kind in $KINDS; do
+        for arms in $ARMS; do
+            src="$OUT/$kind-$arms.cxx"
+            generate "$kind" "$arms" >"$src"
+
+            stats="$OUT/$cxx-$kind-$arms.time"
+            status=ok
+            if [ -x /usr/bin/time ]; then
+                # shellcheck disable=SC2086
+                /usr/bin/time -f '%e %M' -o "$stats" "$cxx" $CPPFLAGS $CXXFLAGS -c -o /dev/null "$src" 2>"$OUT/$cxx-$kind-$arms.log" || status=failed
+                read -r secs rss <"$stats"
+                rss=$(awk "BEGIN { printf \"%.1f\", $rss / 1024 }")
+            else
+                start=$(now)
+                # shellcheck disable=SC2086
+                "$cxx" $CPPFLAGS $CXXFLAGS -c -o /dev/null "$src" 2>"$OUT/$cxx-$kind-$arms.log" || status=failed
+                secs=$(awk "BEGIN { printf \"%.2f\", $(now) - $start }")
+                rss=-
+            fi
+
+            if [ "$status" = ok ]; then
+                printf '%-12s %-9s %6d %10s %12s\n' "$cxx" "$kind" "$arms" "$secs" "$rss"
+            else
+                printf '%-12s %-9s %6d %10s %12s  (see %s)\n' "$cxx" "$kind" "$arms" failed - "$OUT/$cxx-$kind-$arms.log"
+            fi
+        done
+    done
+done
@@ -0,0 +1,91 @@
+#include <match.hxx>
+
+#include "bench-helper.hxx"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Arm `I` matches `3 * I`, so the keys are sparse but within a small range. One in nine inputs matches no arm.
+template <std::size_t N>
+const std::vector<int> &inputs()
+{
+    static const std::vector<int> _inputs{[]
+                                          {
+                                              std::vector<int> _keys;
+                                              for (std::size_t _i = 0; _i < N; _i++)
+                                                  _keys.push_back(static_cast<int>(3 * _i));
+                                              for (std::size_t _i = 0; _i < N / 8 + 1; _i++)
+                                                  _keys.push_back(static_cast<int>(3 * _i + 1));
+                                              return cxx_benches::sample<int>(_keys);
+                                          }()};
+    return _inputs;
+}
+
+template <std::size_t... Is>
+int match_dispatch(int _val, std::index_sequence<Is...>)
+{
+    return cxx_patterns::match(_val,
+                               cxx_patterns::match_arm{cxx_patterns::constant<static_cast<int>(3 * Is)>{}, []
+                                                       { return static_cast<int>(Is); }}...,
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](int)
+                                                       { return -1; }});
+}
+
+#define SWITCH_CASE(I) \
+    case (I) * 3:      \
+        return (I);
+#define SWITCH_CASES4(B) SWITCH_CASE(B) SWITCH_CASE(B + 1) SWITCH_CASE(B + 2) SWITCH_CASE(B + 3)
+#define SWITCH_CASES16(B) SWITCH_CASES4(B) SWITCH_CASES4(B + 4) SWITCH_CASES4(B + 8) SWITCH_CASES4(B + 12)
+#define SWITCH_CASES64(B) SWITCH_CASES16(B) SWITCH_CASES16(B + 16) SWITCH_CASES16(B + 32) SWITCH_CASES16(B + 48)
+
+template <std::size_t N>
+int switch_dispatch(int _val)
+{
+    if constexpr (N == 4)
+    {
+        switch (_val)
+        {
+            SWITCH_CASES4(0)
+        }
+    }
+    else if constexpr (N == 16)
+    {
+        switch (_val)
+        {
+            SWITCH_CASES16(0)
+        }
+    }
+    else
+    {
+        static_assert(N == 64);
+        switch (_val)
+        {
+            SWITCH_CASES64(0)
+        }
+    }
+    return -1;
+}
+
+template <std::size_t N>
+std::uint64_t integral_match()
+{
+    std::uint64_t _sum{};
+    for (int _val : inputs<N>())
+        _sum += static_cast<std::uint64_t>(match_dispatch(_val, std::make_index_sequence<N>{}));
+    return _sum;
+}
+
+template <std::size_t N>
+std::uint64_t integral_switch()
+{
+    std::uint64_t _sum{};
+    for (int _val : inputs<N>())
+        _sum += static_cast<std::uint64_t>(switch_dispatch<N>(_val));
+    return _sum;
+}
+
+BENCH_DRIVER(cxx_benches::make_bench(integral_match<4>), cxx_benches::make_bench(integral_switch<4>),
+             cxx_benches::make_bench(integral_match<16>), cxx_benches::make_bench(integral_switch<16>),
+             cxx_benches::make_bench(integral_match<64>), cxx_benches::make_bench(integral_switch<64>));
@@ -0,0 +1,98 @@
+#include <match.hxx>
+
+#include "bench-helper.hxx"
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+// Arm `I` matches "key_" followed by `I` in decimal, written as two digits. One in nine inputs matches no arm.
+template <std::size_t I>
+struct key_chars
+{
+    static constexpr char value[]{'k', 'e', 'y', '_', static_cast<char>('0' + I / 10), static_cast<char>('0' + I % 10), '\0'};
+
+    static constexpr std::string_view view{value, sizeof(value) - 1};
+};
+
+template <std::size_t I>
+using key_pattern = cxx_patterns::string_constant<cxx_patterns::basic_fixed_string<char, sizeof(key_chars<I>::value) - 1>{key_chars<I>::value}>;
+
+template <std::size_t N>
+const std::vector<std::string_view> &inputs()
+{
+    static const std::vector<std::string_view> _inputs{[]
+                                                       {
+                                                           std::vector<std::string_view> _keys{[]<std::size_t... Is>(std::index_sequence<Is...>)
+                                                                                               { return std::vector<std::string_view>{key_chars<Is>::view...}; }(std::make_index_sequence<N>{})};
+                                                           for (std::size_t _i = 0; _i < N / 8 + 1; _i++)
+                                                               _keys.push_back("key_xx"sv);
+                                                           return cxx_benches::sample<std::string_view>(_keys);
+                                                       }()};
+    return _inputs;
+}
+
+template <std::size_t... Is>
+int match_dispatch(std::string_view _val, std::index_sequence<Is...>)
+{
+    return cxx_patterns::match(_val,
+                               cxx_patterns::match_arm{key_pattern<Is>{}, []
+                                                       { return static_cast<int>(Is); }}...,
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](std::string_view)
+                                                       { return -1; }});
+}
+
+template <std::size_t... Is>
+int if_chain_dispatch(std::string_view _val, std::index_sequence<Is...>)
+{
+    int _res{-1};
+    static_cast<void>(((_val == key_chars<Is>::view ? (_res = static_cast<int>(Is), true) : false) || ...));
+    return _res;
+}
+
+template <std::size_t N>
+int map_dispatch(std::string_view _val)
+{
+    static const std::unordered_map<std::string_view, int> _map{[]<std::size_t... Is>(std::index_sequence<Is...>)
+                                                                { return std::unordered_map<std::string_view, int>{{key_chars<Is>::view, static_cast<int>(Is)}...}; }(std::make_index_sequence<N>{})};
+
+    if (auto _it = _map.find(_val); _it != _map.end())
+        return _it->second;
+    else
+        return -1;
+}
+
+template <std::size_t N>
+std::uint64_t string_match()
+{
+    std::uint64_t _sum{};
+    for (std::string_view _val : inputs<N>())
+        _sum += static_cast<std::uint64_t>(match_dispatch(_val, std::make_index_sequence<N>{}));
+    return _sum;
+}
+
+template <std::size_t N>
+std::uint64_t string_if_chain()
+{
+    std::uint64_t _sum{};
+    for (std::string_view _val : inputs<N>())
+        _sum += static_cast<std::uint64_t>(if_chain_dispatch(_val, std::make_index_sequence<N>{}));
+    return _sum;
+}
+
+template <std::size_t N>
+std::uint64_t string_unordered_map()
+{
+    std::uint64_t _sum{};
+    for (std::string_view _val : inputs<N>())
+        _sum += static_cast<std::uint64_t>(map_dispatch<N>(_val));
+    return _sum;
+}
+
+BENCH_DRIVER(cxx_benches::make_bench(string_match<4>), cxx_benches::make_bench(string_if_chain<4>), cxx_benches::make_bench(string_unordered_map<4>),
+             cxx_benches::make_bench(string_match<16>), cxx_benches::make_bench(string_if_chain<16>), cxx_benches::make_bench(string_unordered_map<16>),
+             cxx_benches::make_bench(string_match<64>), cxx_benches::make_bench(string_if_chain<64>), cxx_benches::make_bench(string_unordered_map<64>));
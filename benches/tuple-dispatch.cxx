@@ -0,0 +1,77 @@
+#include <match.hxx>
+
+#include "bench-helper.hxx"
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using record = std::tuple<int, int, int>;
+
+// Arm `I` matches records whose first two fields are `I % 8` and `I / 8`, and binds the third. One in nine inputs matches no arm.
+template <std::size_t N>
+const std::vector<record> &inputs()
+{
+    static const std::vector<record> _inputs{[]
+                                             {
+                                                 std::vector<record> _keys;
+                                                 for (std::size_t _i = 0; _i < N; _i++)
+                                                     _keys.emplace_back(static_cast<int>(_i % 8), static_cast<int>(_i / 8), static_cast<int>(_i));
+                                                 for (std::size_t _i = 0; _i < N / 8 + 1; _i++)
+                                                     _keys.emplace_back(static_cast<int>(_i % 8), -1, static_cast<int>(_i));
+                                                 return cxx_benches::sample<record>(_keys);
+                                             }()};
+    return _inputs;
+}
+
+template <std::size_t... Is>
+int match_dispatch(const record &_val, std::index_sequence<Is...>)
+{
+    return cxx_patterns::match(_val,
+                               cxx_patterns::match_arm{std::tuple{cxx_patterns::constant<static_cast<int>(Is % 8)>{}, cxx_patterns::constant<static_cast<int>(Is / 8)>{}, cxx_patterns::binding{}},
+                                                       [](const int &_z)
+                                                       { return static_cast<int>(Is) + _z; }}...,
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](const record &)
+                                                       { return -1; }});
+}
+
+// Arms `A`, `A + 8`, ... as a hand-written `if` on the second field, reached once the first field is known to be `A`
+template <std::size_t A, std::size_t... Bs>
+int nested_if_second(const record &_val, std::index_sequence<Bs...>)
+{
+    int _res{-1};
+    static_cast<void>(((std::get<1>(_val) == static_cast<int>(Bs) ? (_res = static_cast<int>(Bs * 8 + A) + std::get<2>(_val), true) : false) || ...));
+    return _res;
+}
+
+// The `N` arms as nested `if`s: the first field is tested once, and then only against the second fields of the arms that share it
+template <std::size_t N, std::size_t... As>
+int nested_if_dispatch(const record &_val, std::index_sequence<As...>)
+{
+    int _res{-1};
+    static_cast<void>(((std::get<0>(_val) == static_cast<int>(As) ? (_res = nested_if_second<As>(_val, std::make_index_sequence<(N - As + 7) / 8>{}), true) : false) || ...));
+    return _res;
+}
+
+template <std::size_t N>
+std::uint64_t tuple_match()
+{
+    std::uint64_t _sum{};
+    for (const record &_val : inputs<N>())
+        _sum += static_cast<std::uint64_t>(match_dispatch(_val, std::make_index_sequence<N>{}));
+    return _sum;
+}
+
+template <std::size_t N>
+std::uint64_t tuple_nested_if()
+{
+    std::uint64_t _sum{};
+    for (const record &_val : inputs<N>())
+        _sum += static_cast<std::uint64_t>(nested_if_dispatch<N>(_val, std::make_index_sequence<(N < 8 ? N : 8)>{}));
+    return _sum;
+}
+
+BENCH_DRIVER(cxx_benches::make_bench(tuple_match<4>), cxx_benches::make_bench(tuple_nested_if<4>),
+             cxx_benches::make_bench(tuple_match<16>), cxx_benches::make_bench(tuple_nested_if<16>),
+             cxx_benches::make_bench(tuple_match<64>), cxx_benches::make_bench(tuple_nested_if<64>));
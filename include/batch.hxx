@@ -0,0 +1,392 @@
+#pragma once
+
+#include <match.hxx>
+#include <integral-patterns.hxx>
+#include <interval-table.hxx>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined(CXX_PATTERNS_NO_SIMD) && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+namespace cxx_patterns
+{
+    namespace _detail
+    {
+#if !defined(CXX_PATTERNS_NO_SIMD) && defined(__AVX2__)
+        using _simd_vec = __m256i;
+
+        constexpr inline std::size_t _simd_bytes{32};
+
+        template <std::size_t W>
+        constexpr inline bool _simd_supported{W == 1 || W == 2 || W == 4 || W == 8};
+
+        inline _simd_vec _simd_load(const void *_p) noexcept { return _mm256_loadu_si256(static_cast<const __m256i *>(_p)); }
+        inline void _simd_store(void *_p, _simd_vec _v) noexcept { _mm256_storeu_si256(static_cast<__m256i *>(_p), _v); }
+        inline _simd_vec _simd_and(_simd_vec _a, _simd_vec _b) noexcept { return _mm256_and_si256(_a, _b); }
+        inline _simd_vec _simd_andnot(_simd_vec _a, _simd_vec _b) noexcept { return _mm256_andnot_si256(_a, _b); }
+        inline _simd_vec _simd_or(_simd_vec _a, _simd_vec _b) noexcept { return _mm256_or_si256(_a, _b); }
+        inline _simd_vec _simd_xor(_simd_vec _a, _simd_vec _b) noexcept { return _mm256_xor_si256(_a, _b); }
+
+        template <std::size_t W>
+        inline _simd_vec _simd_set1(std::uint64_t _v) noexcept
+        {
+            if constexpr (W == 1)
+                return _mm256_set1_epi8(static_cast<char>(_v));
+            else if constexpr (W == 2)
+                return _mm256_set1_epi16(static_cast<short>(_v));
+            else if constexpr (W == 4)
+                return _mm256_set1_epi32(static_cast<int>(_v));
+            else
+                return _mm256_set1_epi64x(static_cast<long long>(_v));
+        }
+
+        template <std::size_t W>
+        inline _simd_vec _simd_sub(_simd_vec _a, _simd_vec _b) noexcept
+        {
+            if constexpr (W == 1)
+                return _mm256_sub_epi8(_a, _b);
+            else if constexpr (W == 2)
+                return _mm256_sub_epi16(_a, _b);
+            else if constexpr (W == 4)
+                return _mm256_sub_epi32(_a, _b);
+            else
+                return _mm256_sub_epi64(_a, _b);
+        }
+
+        template <std::size_t W>
+        inline _simd_vec _simd_cmpgt(_simd_vec _a, _simd_vec _b) noexcept
+        {
+            if constexpr (W == 1)
+                return _mm256_cmpgt_epi8(_a, _b);
+            else if constexpr (W == 2)
+                return _mm256_cmpgt_epi16(_a, _b);
+            else if constexpr (W == 4)
+                return _mm256_cmpgt_epi32(_a, _b);
+            else
+                return _mm256_cmpgt_epi64(_a, _b);
+        }
+#elif !defined(CXX_PATTERNS_NO_SIMD) && defined(__SSE2__)
+        using _simd_vec = __m128i;
+
+        constexpr inline std::size_t _simd_bytes{16};
+
+#if defined(__SSE4_2__)
+        template <std::size_t W>
+        constexpr inline bool _simd_supported{W == 1 || W == 2 || W == 4 || W == 8};
+#else
+        template <std::size_t W>
+        constexpr inline bool _simd_supported{W == 1 || W == 2 || W == 4};
+#endif
+
+        inline _simd_vec _simd_load(const void *_p) noexcept { return _mm_loadu_si128(static_cast<const __m128i *>(_p)); }
+        inline void _simd_store(void *_p, _simd_vec _v) noexcept { _mm_storeu_si128(static_cast<__m128i *>(_p), _v); }
+        inline _simd_vec _simd_and(_simd_vec _a, _simd_vec _b) noexcept { return _mm_and_si128(_a, _b); }
+        inline _simd_vec _simd_andnot(_simd_vec _a, _simd_vec _b) noexcept { return _mm_andnot_si128(_a, _b); }
+        inline _simd_vec _simd_or(_simd_vec _a, _simd_vec _b) noexcept { return _mm_or_si128(_a, _b); }
+        inline _simd_vec _simd_xor(_simd_vec _a, _simd_vec _b) noexcept { return _mm_xor_si128(_a, _b); }
+
+        template <std::size_t W>
+        inline _simd_vec _simd_set1(std::uint64_t _v) noexcept
+        {
+            if constexpr (W == 1)
+                return _mm_set1_epi8(static_cast<char>(_v));
+            else if constexpr (W == 2)
+                return _mm_set1_epi16(static_cast<short>(_v));
+            else if constexpr (W == 4)
+                return _mm_set1_epi32(static_cast<int>(_v));
+            else
+                return _mm_set1_epi64x(static_cast<long long>(_v));
+        }
+
+        template <std::size_t W>
+        inline _simd_vec _simd_sub(_simd_vec _a, _simd_vec _b) noexcept
+        {
+            if constexpr (W == 1)
+                return _mm_sub_epi8(_a, _b);
+            else if constexpr (W == 2)
+                return _mm_sub_epi16(_a, _b);
+            else if constexpr (W == 4)
+                return _mm_sub_epi32(_a, _b);
+            else
+                return _mm_sub_epi64(_a, _b);
+        }
+
+        template <std::size_t W>
+        inline _simd_vec _simd_cmpgt(_simd_vec _a, _simd_vec _b) noexcept
+        {
+            if constexpr (W == 1)
+                return _mm_cmpgt_epi8(_a, _b);
+            else if constexpr (W == 2)
+                return _mm_cmpgt_epi16(_a, _b);
+            else if constexpr (W == 4)
+                return _mm_cmpgt_epi32(_a, _b);
+            else
+                return _mm_cmpgt_epi64(_a, _b);
+        }
+#else
+        constexpr inline std::size_t _simd_bytes{0};
+
+        template <std::size_t W>
+        constexpr inline bool _simd_supported{false};
+#endif
+
+        /// @brief The maximum number of interval arms that are classified with vector comparisons. Larger arm lists use the scalar `_interval_table` lookup, which does not depend on the number of arms.
+        constexpr inline std::size_t _batch_simd_max_arms{16};
+
+        /// @brief The number of elements classified at a time into a local buffer
+        constexpr inline std::size_t _batch_block{256};
+
+        /// @brief Classifies blocks of integral values against a list of intervals, as `_interval_table<T, _Intervals>::first_match` would.
+        ///
+        /// When vector instructions are available for the width of `T`, each vector of values is compared against every interval, from the last to the first,
+        ///  so that the earliest matching arm is the one left in each lane. Values that fit no vector are looked up in the `_interval_table`.
+        template <typename T, auto _Intervals>
+        struct _batch_classifier
+        {
+            using lane_type = std::make_unsigned_t<T>;
+
+            static constexpr std::size_t arms{_Intervals.size()};
+
+            using _table = _interval_table<T, _Intervals>;
+
+            static constexpr bool vectorized{_simd_supported<sizeof(T)> && arms <= _batch_simd_max_arms && arms < std::numeric_limits<lane_type>::max()};
+
+#if !defined(CXX_PATTERNS_NO_SIMD) && (defined(__SSE2__) || defined(__AVX2__))
+            static constexpr lane_type _s_sign{static_cast<lane_type>(lane_type{1} << (std::numeric_limits<lane_type>::digits - 1))};
+
+            template <std::size_t I>
+            static void _blend_arm(_simd_vec _vals, _simd_vec &_res) noexcept
+            {
+                constexpr _interval<T> _iv{_Intervals[I]};
+                if constexpr (!_iv.empty)
+                {
+                    constexpr std::size_t _w{sizeof(T)};
+                    constexpr lane_type _span{static_cast<lane_type>(static_cast<lane_type>(_iv.upper) - static_cast<lane_type>(_iv.lower))};
+
+                    // `v` is in `[lower, upper]` iff `v - lower <= upper - lower` as unsigned values. Flipping the sign bit lets the signed comparison order unsigned values.
+                    _simd_vec _off{_simd_xor(_simd_sub<_w>(_vals, _simd_set1<_w>(static_cast<lane_type>(_iv.lower))), _simd_set1<_w>(_s_sign))};
+                    _simd_vec _outside{_simd_cmpgt<_w>(_off, _simd_set1<_w>(static_cast<lane_type>(_span ^ _s_sign)))};
+                    _res = _simd_or(_simd_and(_outside, _res), _simd_andnot(_outside, _simd_set1<_w>(I)));
+                }
+            }
+#endif
+
+            /// @brief Writes the index of the first interval containing `_in[i]` (or `arms` if there is none) to `_out[i]`, for each `i` less than `_n`
+            static void classify(const T *_in, std::size_t _n, lane_type *_out) noexcept
+            {
+                std::size_t _i{0};
+#if !defined(CXX_PATTERNS_NO_SIMD) && (defined(__SSE2__) || defined(__AVX2__))
+                if constexpr (vectorized)
+                {
+                    constexpr std::size_t _lanes{_simd_bytes / sizeof(T)};
+                    for (; _i + _lanes <= _n; _i += _lanes)
+                    {
+                        _simd_vec _vals{_simd_load(_in + _i)};
+                        _simd_vec _res{_simd_set1<sizeof(T)>(arms)};
+                        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                        {
+                            (_blend_arm<arms - 1 - Is>(_vals, _res), ...);
+                        }(std::make_index_sequence<arms>{});
+                        _simd_store(_out + _i, _res);
+                    }
+                }
+#endif
+                for (; _i < _n; _i++)
+                    _out[_i] = static_cast<lane_type>(_table::first_match(_in[_i]));
+            }
+        };
+
+        template <typename T, typename... Pats>
+        concept _batch_intervals = _interval_scrutinee<T> && (sizeof...(Pats) != 0) && (constant_interval_pattern<Pats> && ...);
+
+        template <typename T, typename... Pats>
+        using _batch_classifier_for = _batch_classifier<T, _prefix_intervals<T, sizeof...(Pats), Pats...>>;
+
+        template <typename Elem, typename... Pats>
+        constexpr std::size_t _first_matching(Elem &&_elem, const Pats &..._pats) noexcept((cxx_patterns::noexcept_pattern<Pats, Elem &> && ... && true))
+        {
+            std::size_t _idx{0};
+            static_cast<void>(((cxx_patterns::match_pattern(_pats, _elem) ? true : (++_idx, false)) || ...));
+            return _idx;
+        }
+
+        /// @brief Calls `_f(_first, _indices, _count)` for each block of at most `_batch_block` elements of `_in`, where `_indices` holds the index of the first pattern of `_pats` that matches each element
+        template <typename T, typename F, typename... Pats>
+        void _for_each_classified_block(std::span<const T> _in, F &&_f, const Pats &..._pats)
+        {
+            if constexpr (_batch_intervals<T, Pats...>)
+            {
+                using _classifier = _batch_classifier_for<T, Pats...>;
+                typename _classifier::lane_type _indices[_batch_block];
+
+                for (std::size_t _first = 0; _first < _in.size(); _first += _batch_block)
+                {
+                    const std::size_t _count{std::min(_batch_block, _in.size() - _first)};
+                    _classifier::classify(_in.data() + _first, _count, _indices);
+                    _f(_first, static_cast<const typename _classifier::lane_type *>(_indices), _count);
+                }
+            }
+            else
+            {
+                std::size_t _indices[_batch_block];
+
+                for (std::size_t _first = 0; _first < _in.size(); _first += _batch_block)
+                {
+                    const std::size_t _count{std::min(_batch_block, _in.size() - _first)};
+                    for (std::size_t _i = 0; _i < _count; _i++)
+                        _indices[_i] = _detail::_first_matching(_in[_first + _i], _pats...);
+                    _f(_first, static_cast<const std::size_t *>(_indices), _count);
+                }
+            }
+        }
+
+        /// @brief Whether the arm with pattern `Pat` and body `F`, applied to elements referred to as `Ref`, can be invoked knowing only that its pattern matched:
+        ///  the pattern binds nothing, and also matches the elements as `const T &`
+        template <typename Ref, typename T, typename Pat, typename F>
+        concept _batch_classified_arm = std::same_as<typename _arm_traits<Ref, Pat, F &>::outputs, empty_matcher_t> && cxx_patterns::pattern<cxx_patterns::matcher<Pat>, const T &>;
+
+        /// @brief The pattern by which `match_many` classifies elements for an arm with matcher `_matcher`: the arm's own pattern if it is a `constant_interval_pattern`, so that the interval kernels apply, and otherwise the matcher
+        template <typename Pat>
+        constexpr decltype(auto) _batch_pattern(const cxx_patterns::matcher<Pat> &_matcher) noexcept
+        {
+            if constexpr (constant_interval_pattern<Pat>)
+                return _matcher.pattern();
+            else
+                return (_matcher);
+        }
+
+        /// @brief The cases of the `_switch_index` of `match_many`: case `I` invokes the body of arm `I`
+        struct _batch_case
+        {
+            template <std::size_t I, typename A>
+            static constexpr _regular_void call(const _arm_pack_leaf<I, A> &_leaf)
+            {
+                static_cast<void>(std::apply(_detail::_arm_at(_leaf)._m_arm, empty_matcher_t{}));
+                return {};
+            }
+        };
+
+        template <typename R>
+        concept _batch_input = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>;
+
+        template <typename R>
+        using _batch_element_t = std::ranges::range_value_t<R>;
+    }
+
+    /// @brief Classifies each element of a contiguous range by the first pattern that matches it
+    ///
+    /// For each `i` less than the size of `in`, stores to `out[i]` the index of the first pattern in `pats` that matches `in[i]`, or `sizeof...(Pats)` if none do.
+    ///
+    /// If the elements are integral and every pattern is a `constant_interval_pattern`, the elements are classified with vector comparisons where they are available for the element width (SSE2, SSE4.2 or AVX2),
+    ///  and with an interval table lookup otherwise. Defining `CXX_PATTERNS_NO_SIMD` disables the vector comparisons. Otherwise, each pattern is tested in turn, as by `match_pattern`.
+    ///
+    /// @pre `out` shall have at least as many elements as `in`, and each index shall be representable in the element type of `out`
+    template <typename R, typename Out, typename... Pats>
+        requires _detail::_batch_input<R> && std::ranges::contiguous_range<Out> && std::unsigned_integral<std::ranges::range_value_t<Out>> &&
+                 (cxx_patterns::pattern<Pats, const _detail::_batch_element_t<R> &> && ...)
+    void classify(R &&_in, Out &&_out, const Pats &..._pats)
+    {
+        std::span<const _detail::_batch_element_t<R>> _elems{_in};
+        auto *_dest{std::ranges::data(_out)};
+
+        _detail::_for_each_classified_block(_elems, [_dest](std::size_t _first, const auto *_indices, std::size_t _count)
+                                            { std::copy_n(_indices, _count, _dest + _first); }, _pats...);
+    }
+
+    /// @brief Counts how many elements of a contiguous range are matched first by each pattern
+    ///
+    /// Returns an array `counts`, where `counts[i]` is the number of elements `e` of `in` for which `classify` would produce `i`.
+    /// `counts[sizeof...(Pats)]` is the number of elements that match no pattern.
+    template <typename R, typename... Pats>
+        requires _detail::_batch_input<R> && (cxx_patterns::pattern<Pats, const _detail::_batch_element_t<R> &> && ...)
+    std::array<std::size_t, sizeof...(Pats) + 1> count_matches(R &&_in, const Pats &..._pats)
+    {
+        std::span<const _detail::_batch_element_t<R>> _elems{_in};
+        std::array<std::size_t, sizeof...(Pats) + 1> _counts{};
+
+        _detail::_for_each_classified_block(_elems, [&_counts](std::size_t, const auto *_indices, std::size_t _count)
+                                            {
+                                                for (std::size_t _i = 0; _i < _count; _i++)
+                                                    _counts[_indices[_i]]++; }, _pats...);
+
+        return _counts;
+    }
+
+    /// @brief Copies the elements of a contiguous range into `out`, grouped by the first pattern that matches them
+    ///
+    /// Returns an array `offsets`, such that the elements matched first by pattern `i` are stored in `out[offsets[i]]` up to (but excluding) `out[offsets[i + 1]]`,
+    ///  in the same order as in `in`. The elements that match no pattern are stored last, from `out[offsets[sizeof...(Pats)]]`.
+    ///
+    /// @pre `out` shall have at least as many elements as `in`
+    template <typename R, typename Out, typename... Pats>
+        requires _detail::_batch_input<R> && std::ranges::contiguous_range<Out> && std::assignable_from<std::ranges::range_reference_t<Out>, const _detail::_batch_element_t<R> &> &&
+                 (cxx_patterns::pattern<Pats, const _detail::_batch_element_t<R> &> && ...)
+    std::array<std::size_t, sizeof...(Pats) + 2> partition_matches(R &&_in, Out &&_out, const Pats &..._pats)
+    {
+        std::span<const _detail::_batch_element_t<R>> _elems{_in};
+
+        // The elements are classified once: the index of each is kept while counting, and reused to scatter the elements
+        std::vector<_detail::_smallest_index_t<sizeof...(Pats)>> _arms(_elems.size());
+        std::array<std::size_t, sizeof...(Pats) + 1> _counts{};
+        _detail::_for_each_classified_block(_elems, [&](std::size_t _first, const auto *_indices, std::size_t _count)
+                                            {
+                                                for (std::size_t _i = 0; _i < _count; _i++)
+                                                {
+                                                    _arms[_first + _i] = static_cast<_detail::_smallest_index_t<sizeof...(Pats)>>(_indices[_i]);
+                                                    _counts[_indices[_i]]++;
+                                                } }, _pats...);
+
+        std::array<std::size_t, sizeof...(Pats) + 2> _offsets{};
+        for (std::size_t _i = 0; _i < _counts.size(); _i++)
+            _offsets[_i + 1] = _offsets[_i] + _counts[_i];
+
+        std::array<std::size_t, sizeof...(Pats) + 1> _cursors{};
+        std::copy_n(_offsets.begin(), _cursors.size(), _cursors.begin());
+
+        auto *_dest{std::ranges::data(_out)};
+        for (std::size_t _i = 0; _i < _elems.size(); _i++)
+            _dest[_cursors[_arms[_i]]++] = _elems[_i];
+
+        return _offsets;
+    }
+
+    /// @brief Matches each element of a contiguous range against `arms`, as if by `cxx_patterns::match`, and discards the results.
+    ///
+    /// Unlike `cxx_patterns::match`, an element that matches no arm is skipped.
+    /// If no arm binds anything from the element (as with every `constant_interval_pattern`), the elements are classified a block at a time, as by `classify`, and the body of the arm each one is classified as is invoked directly.
+    /// Otherwise each element is matched against the arms in turn, since their bodies need the outputs of the pattern that matched.
+    template <typename R, typename... Pat, typename... F>
+        requires _detail::_batch_input<R> && (cxx_patterns::matchable<cxx_patterns::matcher<Pat>, std::ranges::range_reference_t<R>, F &> && ... && true)
+    void match_many(R &&_in, match_arm<Pat, F> &&..._arms)
+    {
+        using _elem_t = _detail::_batch_element_t<R>;
+
+        if constexpr (sizeof...(Pat) != 0 && (_detail::_batch_classified_arm<std::ranges::range_reference_t<R>, _elem_t, Pat, F> && ...))
+        {
+            std::span<const _elem_t> _elems{_in};
+            const _detail::_arm_pack<match_arm<Pat, F> &...> _pack{{_arms}...};
+
+            _detail::_for_each_classified_block(_elems, [&_pack](std::size_t, const auto *_indices, std::size_t _count)
+                                                {
+                for (std::size_t _i = 0; _i < _count; _i++)
+                    if (_indices[_i] < sizeof...(Pat))
+                        _detail::_switch_index<_detail::_regular_void, _detail::_batch_case, sizeof...(Pat)>(_indices[_i], _pack); }, _detail::_batch_pattern(_arms._m_pat)...);
+        }
+        else
+        {
+            for (auto &&_elem : _in)
+                static_cast<void>((static_cast<bool>(_arms(_elem)) || ...));
+        }
+    }
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <pattern-base.hxx>
+#include <type-traits.hxx>
+#include <interval-table.hxx>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cxx_patterns
+{
+    namespace _detail
+    {
+        template <typename K>
+        concept _class_kind = (std::integral<K> && !std::same_as<K, bool>) || (std::is_enum_v<K> && !std::same_as<std::underlying_type_t<K>, bool>);
+    }
+
+    /// @brief A concept for the base of a class hierarchy that records the dynamic type of each object in a kind tag
+    ///
+    /// A type `B` satisfies `kind_tagged` if `b.kind()`, for a `const B &b`, returns a value of an integral type other than `bool`, or of an enumeration type.
+    /// That type is `class_kind_t<B>`.
+    template <typename B>
+    concept kind_tagged = std::is_class_v<B> && requires(const B &_obj) {
+        requires _detail::_class_kind<std::remove_cvref_t<decltype(_obj.kind())>>;
+    };
+
+    template <kind_tagged B>
+    using class_kind_t = std::remove_cvref_t<decltype(std::declval<const B &>().kind())>;
+
+    namespace _detail
+    {
+        template <typename D, typename B>
+        concept _kind_range_subclass = kind_tagged<B> && requires {
+            requires std::same_as<std::remove_cv_t<decltype(D::first_kind)>, class_kind_t<B>>;
+            requires std::same_as<std::remove_cv_t<decltype(D::last_kind)>, class_kind_t<B>>;
+            std::integral_constant<class_kind_t<B>, D::first_kind>{};
+            std::integral_constant<class_kind_t<B>, D::last_kind>{};
+        };
+
+        template <typename D, typename B>
+        concept _classof_subclass = requires(const B *_ptr) {
+            { D::classof(_ptr) } -> std::convertible_to<bool>;
+        };
+    }
+
+    /// @brief A concept for classes whose instances can be recognized, without RTTI, from a reference to their base class `B`
+    ///
+    /// A type `D` satisfies `identifiable_subclass<D, B>` if `D` is `B` or a base of `B`, or if `D` is derived from `B`, and either:
+    /// * `B` is `kind_tagged`, and `D::first_kind` and `D::last_kind` are constant expressions of type `class_kind_t<B>`; or
+    /// * `D::classof(p)`, for a `const B *p`, is convertible to `bool`, as in LLVM's `isa`.
+    ///
+    /// `D` models `identifiable_subclass<D, B>` if, for every object `b` of a type derived from `B`, `b` is an instance of `D` (or of a class derived from `D`)
+    ///  exactly when `D::first_kind <= b.kind() && b.kind() <= D::last_kind` if the first applies, or when `D::classof(&b)` otherwise.
+    /// Static members are inherited, so every class that is matched must declare its own `first_kind` and `last_kind`.
+    template <typename D, typename B>
+    concept identifiable_subclass = std::is_class_v<D> && std::is_class_v<B> &&
+                                    (std::derived_from<B, D> || (std::derived_from<D, B> && (_detail::_kind_range_subclass<D, B> || _detail::_classof_subclass<D, B>)));
+
+    namespace _detail
+    {
+        /// @brief The object referred to by a scrutinee of type `V`, which is either a reference to a class, or a pointer to one
+        template <typename V>
+        struct _hierarchy_scrutinee
+        {
+            static constexpr bool pointer{std::is_pointer_v<std::remove_cvref_t<V>>};
+
+            using reference = std::conditional_t<pointer, std::add_lvalue_reference_t<std::remove_pointer_t<std::remove_cvref_t<V>>>, V &&>;
+
+            using base = std::remove_cvref_t<reference>;
+
+            static constexpr reference object(V &_val) noexcept
+            {
+                if constexpr (pointer)
+                    return *_val;
+                else
+                    return static_cast<reference>(_val);
+            }
+        };
+
+        template <typename V, typename D>
+        concept _instance_scrutinee = identifiable_subclass<std::remove_cv_t<D>, typename _hierarchy_scrutinee<V>::base>;
+
+        /// @brief The type of the reference to `D` bound by matching a scrutinee of type `V`, with the cv-qualification and value category of the object `V` refers to
+        template <typename D, typename V>
+        using _downcast_t = forward_cvref_t<D, typename _hierarchy_scrutinee<V>::reference>;
+
+        template <typename D, typename B>
+        constexpr inline bool _nothrow_identifiable{[]
+                                                    {
+                                                        if constexpr (std::derived_from<B, D>)
+                                                            return true;
+                                                        else if constexpr (_kind_range_subclass<D, B>)
+                                                            return noexcept(std::declval<const B &>().kind());
+                                                        else
+                                                            return noexcept(static_cast<bool>(D::classof(std::declval<const B *>())));
+                                                    }()};
+
+        /// @brief Whether `_obj` is an instance of `D`, decided from its kind tag or by `D::classof`
+        template <typename D, typename B>
+        constexpr bool _is_instance(const B &_obj) noexcept(_nothrow_identifiable<D, B>)
+        {
+            if constexpr (std::derived_from<B, D>)
+                return true;
+            else if constexpr (_kind_range_subclass<D, B>)
+            {
+                const class_kind_t<B> _kind{_obj.kind()};
+                return D::first_kind <= _kind && _kind <= D::last_kind;
+            }
+            else
+                return static_cast<bool>(D::classof(&_obj));
+        }
+    }
+
+    /// @brief A pattern that matches an object of a class hierarchy whose dynamic type is `D`, or derived from `D`, without using RTTI
+    ///
+    /// `instance_of<D>` matches a reference `b` to a class `B`, or a non-null pointer to one, if `D` models `identifiable_subclass<D, B>` and `b` is an instance of `D`.
+    /// It binds a reference to `D` obtained by `static_cast`, with the cv-qualification of `B` and the value category of `b` (an lvalue, for a pointer).
+    ///
+    /// `instance_of<D, Pat>` additionally matches the downcast reference against `Pat`, and produces the outputs of `Pat`.
+    ///
+    /// When at least two arms of a `cxx_patterns::match` call on a `kind_tagged` hierarchy use `instance_of` patterns that are decided by kind,
+    ///  `match` reads the kind of the scrutinee once, and looks up the arms that can match it. Those decided by kind are downcast without reading the kind again,
+    ///  and only the others among them are tested in full.
+    template <typename D, typename Pat = void>
+    struct instance_of
+    {
+        using class_type = D;
+
+        Pat _m_pat;
+
+        template <typename V>
+            requires _detail::_instance_scrutinee<V, D> && cxx_patterns::pattern<Pat, _detail::_downcast_t<D, V>>
+        constexpr auto match(V &&_val) const noexcept(_detail::_nothrow_identifiable<std::remove_cv_t<D>, typename _detail::_hierarchy_scrutinee<V>::base> &&
+                                                      cxx_patterns::noexcept_pattern<Pat, _detail::_downcast_t<D, V>>)
+            -> std::optional<cxx_patterns::pattern_outputs_t<Pat, _detail::_downcast_t<D, V>>>
+        {
+            using _hierarchy = _detail::_hierarchy_scrutinee<V>;
+
+            if constexpr (_hierarchy::pointer)
+                if (_val == nullptr)
+                    return std::nullopt;
+
+            auto &&_obj{_hierarchy::object(_val)};
+            if (_detail::_is_instance<std::remove_cv_t<D>>(_obj))
+                return cxx_patterns::match_pattern(this->_m_pat, static_cast<_detail::_downcast_t<D, V>>(_obj));
+            else
+                return std::nullopt;
+        }
+    };
+
+    template <typename D>
+    struct instance_of<D, void>
+    {
+        using class_type = D;
+
+        template <typename V>
+            requires _detail::_instance_scrutinee<V, D>
+        constexpr std::optional<std::tuple<_detail::_downcast_t<D, V>>> match(V &&_val) const
+            noexcept(_detail::_nothrow_identifiable<std::remove_cv_t<D>, typename _detail::_hierarchy_scrutinee<V>::base>)
+        {
+            using _hierarchy = _detail::_hierarchy_scrutinee<V>;
+
+            if constexpr (_hierarchy::pointer)
+                if (_val == nullptr)
+                    return std::nullopt;
+
+            auto &&_obj{_hierarchy::object(_val)};
+            if (_detail::_is_instance<std::remove_cv_t<D>>(_obj))
+                return std::forward_as_tuple(static_cast<_detail::_downcast_t<D, V>>(_obj));
+            else
+                return std::nullopt;
+        }
+    };
+
+    namespace _detail
+    {
+        template <typename V>
+        concept _kind_tagged_scrutinee = (std::is_class_v<std::remove_cvref_t<V>> || std::is_pointer_v<std::remove_cvref_t<V>>) &&
+                                         kind_tagged<typename _hierarchy_scrutinee<V>::base>;
+
+        template <typename Pat>
+        constexpr inline bool _is_instance_of_pattern{false};
+
+        template <typename D, typename Pat>
+        constexpr inline bool _is_instance_of_pattern<instance_of<D, Pat>>{true};
+
+        /// @brief Satisfied if `Pat` is an `instance_of` pattern that is decided by the kind tag of a scrutinee of type `V`
+        template <typename V, typename Pat>
+        concept _kind_pattern_for = _kind_tagged_scrutinee<V> && _is_instance_of_pattern<Pat> &&
+                                    _kind_range_subclass<std::remove_cv_t<typename Pat::class_type>, typename _hierarchy_scrutinee<V>::base> &&
+                                    !std::derived_from<typename _hierarchy_scrutinee<V>::base, std::remove_cv_t<typename Pat::class_type>>;
+
+        /// @brief The number of patterns in `Pats` that are decided by the kind tag of a scrutinee of type `V`. Zero if `V` does not refer to a `kind_tagged` class.
+        template <typename V, typename... Pats>
+        constexpr inline std::size_t _kind_pattern_count{(std::size_t{0} + ... + std::size_t{_kind_pattern_for<V, Pats>})};
+
+        template <typename K>
+        struct _kind_key_type : std::type_identity<K>
+        {
+        };
+
+        template <typename K>
+            requires std::is_enum_v<K>
+        struct _kind_key_type<K> : std::underlying_type<K>
+        {
+        };
+
+        /// @brief The integral type used to look up the kind tag of the object a scrutinee of type `V` refers to
+        template <typename V>
+        using _kind_key_t = typename _kind_key_type<class_kind_t<typename _hierarchy_scrutinee<V>::base>>::type;
+
+        /// @brief The kinds of the objects that the pattern `Pat` may match, as an interval of the underlying integral type. Every kind, for patterns not decided by kind.
+        template <typename V, typename Pat>
+        consteval _interval<_kind_key_t<V>> _kind_interval_of() noexcept
+        {
+            using _key = _kind_key_t<V>;
+            if constexpr (_kind_pattern_for<V, Pat>)
+            {
+                using _class = std::remove_cv_t<typename Pat::class_type>;
+                constexpr _key _lo{static_cast<_key>(_class::first_kind)};
+                constexpr _key _hi{static_cast<_key>(_class::last_kind)};
+                return {_lo, _hi, _hi < _lo};
+            }
+            else
+                return {std::numeric_limits<_key>::min(), std::numeric_limits<_key>::max(), false};
+        }
+
+        template <typename V, typename... Pats>
+        constexpr inline std::array<_interval<_kind_key_t<V>>, sizeof...(Pats)> _kind_intervals{_detail::_kind_interval_of<V, Pats>()...};
+
+        /// @brief The kind of the object a non-null scrutinee `_val` refers to, as a key of the interval table over `_kind_intervals`
+        template <typename V>
+        constexpr _kind_key_t<V> _kind_key_of(V &_val) noexcept(noexcept(_hierarchy_scrutinee<V>::object(_val).kind()))
+        {
+            return static_cast<_kind_key_t<V>>(_hierarchy_scrutinee<V>::object(_val).kind());
+        }
+
+        /// @brief Matches `_pat` against `_val`, as `_pat.match(std::forward<V>(_val))` would, given that `_val` is already known to refer to an instance of `D`, so that its kind is not read again
+        template <typename V, typename D, typename Pat>
+        constexpr auto _match_known_instance(const instance_of<D, Pat> &_pat, V &&_val) noexcept(std::is_void_v<Pat> || cxx_patterns::noexcept_pattern<Pat, _downcast_t<D, V>>)
+        {
+            auto &&_obj{_hierarchy_scrutinee<V>::object(_val)};
+            if constexpr (std::is_void_v<Pat>)
+                return std::optional<std::tuple<_downcast_t<D, V>>>{std::forward_as_tuple(static_cast<_downcast_t<D, V>>(_obj))};
+            else
+                return cxx_patterns::match_pattern(_pat._m_pat, static_cast<_downcast_t<D, V>>(_obj));
+        }
+    }
+}
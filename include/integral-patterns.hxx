@@ -0,0 +1,105 @@
+#pragma once
+
+#include <pattern-base.hxx>
+#include <interval-table.hxx>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace cxx_patterns
+{
+    /// @brief A pattern that matches an integral value equal to the compile-time constant `V`
+    ///
+    /// Unlike a plain integral pattern, the value is part of the type, which allows `cxx_patterns::match` to compile a run of `constant` and `inclusive_range` arms into a lookup table.
+    /// Comparison is value-preserving: `constant<-1>` does not match `static_cast<unsigned>(-1)`.
+    template <auto V>
+        requires std::integral<decltype(V)>
+    struct constant
+    {
+        static constexpr auto lower = V;
+        static constexpr auto upper = V;
+
+        template <std::integral I>
+        constexpr std::optional<empty_matcher_t> match(const I &_val) const noexcept
+        {
+            if (_detail::_int_less_equal(V, _val) && _detail::_int_less_equal(_val, V))
+                return empty_matcher;
+            else
+                return std::nullopt;
+        }
+    };
+
+    /// @brief A pattern that matches an integral value in the inclusive interval `[Lo, Hi]`
+    ///
+    /// If `Hi < Lo`, the pattern matches no values. Comparisons are value-preserving, as for `constant`.
+    template <auto Lo, auto Hi>
+        requires std::integral<decltype(Lo)> && std::integral<decltype(Hi)>
+    struct inclusive_range
+    {
+        static constexpr auto lower = Lo;
+        static constexpr auto upper = Hi;
+
+        template <std::integral I>
+        constexpr std::optional<empty_matcher_t> match(const I &_val) const noexcept
+        {
+            if (_detail::_int_less_equal(Lo, _val) && _detail::_int_less_equal(_val, Hi))
+                return empty_matcher;
+            else
+                return std::nullopt;
+        }
+    };
+
+    /// @brief A concept for patterns that match exactly the integral values in a compile-time interval
+    ///
+    /// A type `Pat` satisfies `constant_interval_pattern` if `Pat::lower` and `Pat::upper` are constant expressions of integral type.
+    ///
+    /// A type `Pat` models `constant_interval_pattern` if it satisfies `constant_interval_pattern`, and for every integral type `I`, `Pat` models `pattern<const I&>`,
+    ///  and matching a value `v` yields `empty_matcher` if `Pat::lower <= v && v <= Pat::upper` (compared value-preserving), and an empty optional otherwise.
+    template <typename Pat>
+    concept constant_interval_pattern = requires {
+        requires std::integral<std::remove_cv_t<decltype(Pat::lower)>>;
+        requires std::integral<std::remove_cv_t<decltype(Pat::upper)>>;
+        std::integral_constant<std::remove_cv_t<decltype(Pat::lower)>, Pat::lower>{};
+        std::integral_constant<std::remove_cv_t<decltype(Pat::upper)>, Pat::upper>{};
+    };
+
+    namespace _detail
+    {
+        template <typename T, typename Pat>
+        constexpr _interval<T> _interval_of() noexcept
+        {
+            if constexpr (constant_interval_pattern<Pat>)
+                return _detail::_clamp_interval<T>(Pat::lower, Pat::upper);
+            else
+                return {std::numeric_limits<T>::min(), std::numeric_limits<T>::min(), true};
+        }
+
+        /// @brief The intervals accepted by the first `K` patterns of `Pats`
+        template <typename T, std::size_t K, typename... Pats>
+        constexpr inline std::array<_interval<T>, K> _prefix_intervals{[]
+                                                                       {
+                                                                           constexpr std::array<_interval<T>, sizeof...(Pats)> _all{_detail::_interval_of<T, Pats>()...};
+                                                                           std::array<_interval<T>, K> _prefix{};
+                                                                           std::copy_n(_all.begin(), K, _prefix.begin());
+                                                                           return _prefix;
+                                                                       }()};
+
+        /// @brief The number of leading patterns in `Pats` that satisfy `constant_interval_pattern`
+        template <typename... Pats>
+        constexpr inline std::size_t _constant_interval_prefix{[]
+                                                               {
+                                                                   constexpr bool _flags[]{constant_interval_pattern<Pats>..., false};
+                                                                   std::size_t _n{};
+                                                                   while (_flags[_n])
+                                                                       _n++;
+                                                                   return _n;
+                                                               }()};
+
+        template <typename T>
+        concept _interval_scrutinee = std::integral<std::remove_cvref_t<T>> && !std::same_as<std::remove_cvref_t<T>, bool>;
+    }
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace cxx_patterns
+{
+    namespace _detail
+    {
+        /// @brief A fixed-size set of arm indices, used by compiled dispatch tables to record which arms may match a given value
+        template <std::size_t N>
+        struct _arm_mask
+        {
+            std::array<std::uint64_t, (N + 63) / 64> _m_words{};
+
+            constexpr void set(std::size_t _idx) noexcept
+            {
+                this->_m_words[_idx / 64] |= std::uint64_t{1} << (_idx % 64);
+            }
+
+            constexpr void reset(std::size_t _idx) noexcept
+            {
+                this->_m_words[_idx / 64] &= ~(std::uint64_t{1} << (_idx % 64));
+            }
+
+            constexpr bool test(std::size_t _idx) const noexcept
+            {
+                return (this->_m_words[_idx / 64] >> (_idx % 64)) & 1;
+            }
+
+            constexpr bool any() const noexcept
+            {
+                return std::ranges::any_of(this->_m_words, [](std::uint64_t _w)
+                                           { return _w != 0; });
+            }
+
+            /// @brief Returns the smallest index in the set that is not less than `_from`, or `N` if there is none
+            constexpr std::size_t next(std::size_t _from = 0) const noexcept
+            {
+                for (std::size_t _w = _from / 64; _w < this->_m_words.size(); _w++)
+                {
+                    std::uint64_t _bits{this->_m_words[_w]};
+                    if (_w == _from / 64)
+                        _bits &= ~std::uint64_t{0} << (_from % 64);
+                    if (_bits)
+                        return _w * 64 + std::countr_zero(_bits);
+                }
+                return N;
+            }
+
+            constexpr _arm_mask &operator&=(const _arm_mask &_other) noexcept
+            {
+                for (std::size_t _w = 0; _w < this->_m_words.size(); _w++)
+                    this->_m_words[_w] &= _other._m_words[_w];
+                return *this;
+            }
+
+            friend constexpr bool operator==(const _arm_mask &, const _arm_mask &) = default;
+        };
+
+        /// @brief An inclusive interval `[lower, upper]` of values of type `T`. An interval with `empty` set matches no values.
+        template <typename T>
+        struct _interval
+        {
+            T lower;
+            T upper;
+            bool empty;
+        };
+
+        template <std::integral A, std::integral B>
+        constexpr bool _int_less(A _a, B _b) noexcept
+        {
+            if constexpr (std::is_signed_v<A> == std::is_signed_v<B>)
+                return _a < _b;
+            else if constexpr (std::is_signed_v<A>)
+                return _a < 0 || static_cast<std::make_unsigned_t<A>>(_a) < _b;
+            else
+                return _b >= 0 && _a < static_cast<std::make_unsigned_t<B>>(_b);
+        }
+
+        template <std::integral A, std::integral B>
+        constexpr bool _int_less_equal(A _a, B _b) noexcept
+        {
+            return !_detail::_int_less(_b, _a);
+        }
+
+        /// @brief Clamps the interval `[_lo, _hi]` (of possibly different integral types) to the values representable by `T`
+        template <std::integral T, std::integral L, std::integral H>
+        constexpr _interval<T> _clamp_interval(L _lo, H _hi) noexcept
+        {
+            constexpr T _min{std::numeric_limits<T>::min()};
+            constexpr T _max{std::numeric_limits<T>::max()};
+
+            if (_detail::_int_less(_hi, _lo) || _detail::_int_less(_max, _lo) || _detail::_int_less(_hi, _min))
+                return {_min, _min, true};
+
+            return {_detail::_int_less(_lo, _min) ? _min : static_cast<T>(_lo), _detail::_int_less(_max, _hi) ? _max : static_cast<T>(_hi), false};
+        }
+
+        template <typename T>
+        using _interval_key_t = std::make_unsigned_t<T>;
+
+        /// @brief Maps `T` onto an unsigned type of the same width, preserving order
+        template <std::integral T>
+        constexpr _interval_key_t<T> _to_interval_key(T _val) noexcept
+        {
+            using _key = _interval_key_t<T>;
+            if constexpr (std::is_signed_v<T>)
+                return static_cast<_key>(static_cast<_key>(_val) ^ (_key{1} << (std::numeric_limits<_key>::digits - 1)));
+            else
+                return static_cast<_key>(_val);
+        }
+
+        template <std::size_t N>
+        using _smallest_index_t = std::conditional_t<(N < std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+                                                     std::conditional_t<(N < std::numeric_limits<std::uint16_t>::max()), std::uint16_t, std::uint32_t>>;
+
+        /// @brief A compile-time lookup table over a list of (possibly overlapping) intervals of `T`.
+        ///
+        /// `_Intervals` is a `std::array<_interval<T>, N>`, where the `I`th element describes the values accepted by arm `I`.
+        /// The value domain of `T` is split into disjoint segments on which the set of accepting arms is constant.
+        /// Lookups use a dense table indexed by `val - min` when the covered range is small relative to the number of segments,
+        ///  and a branchless binary search over the segment starts otherwise.
+        template <std::integral T, auto _Intervals>
+            requires(!std::same_as<T, bool>)
+        struct _interval_table
+        {
+            using key_type = _interval_key_t<T>;
+
+            static constexpr std::size_t arms = _Intervals.size();
+
+            struct _segments_t
+            {
+                std::array<key_type, 2 * arms + 1> starts{};
+                std::array<_arm_mask<arms>, 2 * arms + 1> masks{};
+                std::size_t count{};
+            };
+
+            /// @brief The start or end of an arm's interval, in key order
+            struct _event
+            {
+                key_type key;
+                std::size_t arm;
+                bool start;
+            };
+
+            static consteval _segments_t _build() noexcept
+            {
+                // Sweep over the interval bounds in key order, so that building is O(n log n) in the number of arms rather than O(n^2)
+                std::array<_event, 2 * arms> _events{};
+                std::size_t _n{};
+                for (std::size_t _i = 0; _i < arms; _i++)
+                {
+                    const _interval<T> &_iv{_Intervals[_i]};
+                    if (_iv.empty)
+                        continue;
+                    _events[_n++] = {_detail::_to_interval_key(_iv.lower), _i, true};
+                    if (_detail::_to_interval_key(_iv.upper) != std::numeric_limits<key_type>::max())
+                        _events[_n++] = {static_cast<key_type>(_detail::_to_interval_key(_iv.upper) + 1), _i, false};
+                }
+
+                std::sort(_events.begin(), _events.begin() + _n, [](const _event &_a, const _event &_b)
+                          { return _a.key < _b.key; });
+
+                _segments_t _segs{};
+                _arm_mask<arms> _mask{};
+                std::size_t _e{};
+                key_type _key{0};
+                while (true)
+                {
+                    for (; _e < _n && _events[_e].key == _key; _e++)
+                    {
+                        if (_events[_e].start)
+                            _mask.set(_events[_e].arm);
+                        else
+                            _mask.reset(_events[_e].arm);
+                    }
+
+                    if (_segs.count == 0 || !(_segs.masks[_segs.count - 1] == _mask))
+                    {
+                        _segs.starts[_segs.count] = _key;
+                        _segs.masks[_segs.count] = _mask;
+                        _segs.count++;
+                    }
+
+                    if (_e == _n)
+                        return _segs;
+                    _key = _events[_e].key;
+                }
+            }
+
+            static constexpr _segments_t _s_segments{_build()};
+
+            static constexpr std::size_t _s_count{_s_segments.count};
+
+            using _index_t = _smallest_index_t<arms>;
+            using _segment_t = _smallest_index_t<_s_count>;
+
+            static constexpr std::array<_index_t, _s_count> _s_first{[]
+                                                                     {
+                                                                         std::array<_index_t, _s_count> _first{};
+                                                                         for (std::size_t _k = 0; _k < _s_count; _k++)
+                                                                             _first[_k] = static_cast<_index_t>(_s_segments.masks[_k].next());
+                                                                         return _first;
+                                                                     }()};
+
+            static constexpr std::array<_arm_mask<arms>, _s_count> _s_masks{[]
+                                                                            {
+                                                                                std::array<_arm_mask<arms>, _s_count> _masks{};
+                                                                                std::copy_n(_s_segments.masks.begin(), _s_count, _masks.begin());
+                                                                                return _masks;
+                                                                            }()};
+
+            // The dense table covers the interior segments, `[_s_lo, _s_lo + _s_span]`. Keys below `_s_lo` fall in the first segment, and keys above it in the last.
+            // Arms that accept every value, such as a trailing catch-all, therefore do not widen the table.
+            static constexpr key_type _s_lo{_s_count > 2 ? _s_segments.starts[1] : 0};
+
+            static constexpr key_type _s_span{_s_count > 2 ? static_cast<key_type>(_s_segments.starts[_s_count - 1] - 1 - _s_lo) : 0};
+
+            static constexpr bool _s_dense{_s_count > 2 && static_cast<std::uintmax_t>(_s_span) < 16 * _s_count + 64};
+
+            static constexpr std::size_t _s_dense_size{_s_dense ? static_cast<std::size_t>(_s_span) + 1 : 0};
+
+            static constexpr std::array<_segment_t, _s_dense_size> _s_dense_segment{[]
+                                                                                    {
+                                                                                        std::array<_segment_t, _s_dense_size> _table{};
+                                                                                        std::size_t _k{};
+                                                                                        for (std::size_t _off = 0; _off < _s_dense_size; _off++)
+                                                                                        {
+                                                                                            key_type _key{static_cast<key_type>(_s_lo + _off)};
+                                                                                            while (_k + 1 < _s_count && _s_segments.starts[_k + 1] <= _key)
+                                                                                                _k++;
+                                                                                            _table[_off] = static_cast<_segment_t>(_k);
+                                                                                        }
+                                                                                        return _table;
+                                                                                    }()};
+
+            static constexpr std::array<_index_t, _s_dense_size> _s_dense_first{[]
+                                                                                {
+                                                                                    std::array<_index_t, _s_dense_size> _table{};
+                                                                                    for (std::size_t _off = 0; _off < _s_dense_size; _off++)
+                                                                                        _table[_off] = _s_first[_s_dense_segment[_off]];
+                                                                                    return _table;
+                                                                                }()};
+
+            /// @brief Returns the index of the segment containing `_key`
+            static constexpr std::size_t _segment_of(key_type _key) noexcept
+            {
+                std::size_t _base{0};
+                std::size_t _n{_s_count};
+                while (_n > 1)
+                {
+                    std::size_t _half{_n / 2};
+                    _base = _s_segments.starts[_base + _half] <= _key ? _base + _half : _base;
+                    _n -= _half;
+                }
+                return _base;
+            }
+
+            /// @brief Returns the index of the first arm that accepts `_val`, or `arms` if no arm does
+            static constexpr std::size_t first_match(T _val) noexcept
+            {
+                key_type _key{_detail::_to_interval_key(_val)};
+                if constexpr (_s_dense)
+                {
+                    key_type _off{static_cast<key_type>(_key - _s_lo)};
+                    if (_off <= _s_span)
+                        return _s_dense_first[_off];
+                    else if constexpr (_s_first[0] == _s_first[_s_count - 1])
+                        return _s_first[0];
+                    else
+                        return _key < _s_lo ? _s_first[0] : _s_first[_s_count - 1];
+                }
+                else
+                    return _s_first[_segment_of(_key)];
+            }
+
+            /// @brief Returns the set of arms that accept `_val`
+            static constexpr const _arm_mask<arms> &candidates(T _val) noexcept
+            {
+                key_type _key{_detail::_to_interval_key(_val)};
+                if constexpr (_s_dense)
+                {
+                    key_type _off{static_cast<key_type>(_key - _s_lo)};
+                    if (_off <= _s_span)
+                        return _s_masks[_s_dense_segment[_off]];
+                    else if constexpr (_s_masks[0] == _s_masks[_s_count - 1])
+                        return _s_masks[0];
+                    else
+                        return _key < _s_lo ? _s_masks[0] : _s_masks[_s_count - 1];
+                }
+                else
+                    return _s_masks[_segment_of(_key)];
+            }
+        };
+    }
+}
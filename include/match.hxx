@@ -8,6 +8,13 @@
 #include <optional>
 #include <string_view>
 #include <empty.hxx>
+#include <integral-patterns.hxx>
+#include <string-patterns.hxx>
+#include <variant-patterns.hxx>
+#include <tuple-patterns.hxx>
+#include <slice-patterns.hxx>
+#include <class-patterns.hxx>
+#include <algorithm>
 
 namespace cxx_patterns
 {
@@ -28,7 +35,13 @@ namespace cxx_patterns
             requires cxx_patterns::pattern<Pat, T>
         constexpr auto match(T &&_val) const noexcept(cxx_patterns::noexcept_pattern<Pat, T>)
         {
-            return cxx_patterns::match_pattern(this->_m_pat, _val);
+            return cxx_patterns::match_pattern(this->_m_pat, std::forward<T>(_val));
+        }
+
+        /// @brief The pattern being matched, for dispatch strategies that have already decided part of the match
+        constexpr const Pat &pattern() const noexcept
+        {
+            return this->_m_pat;
         }
     };
 
@@ -43,7 +56,7 @@ namespace cxx_patterns
         {
         }
 
-        constexpr std::optional<empty_matcher_t> match(std::basic_string_view<CharT, CharTraits> _val) noexcept
+        constexpr std::optional<empty_matcher_t> match(std::basic_string_view<CharT, CharTraits> _val) const noexcept
         {
             if (this->_m_pat == _val)
                 return empty_matcher;
@@ -65,23 +78,17 @@ namespace cxx_patterns
         {
         }
 
-        template <typename... Ts, std::size_t... Is>
-            requires(cxx_patterns::pattern<Pats, Ts> && ...)
-        constexpr auto _match_impl(std::tuple<Ts &&...> _tup, std::index_sequence<Is...>) const noexcept((cxx_patterns::noexcept_pattern<Pats, Ts> && ...))
+        template <typename Tuple>
+            requires _detail::_element_pattern<std::tuple<Pats...>, Tuple>
+        constexpr auto match(Tuple &&_tup) const noexcept(_detail::_element_match<std::tuple<Pats...>, Tuple>::nothrow)
         {
-            auto _binders{std::make_tuple(cxx_patterns::match_pattern(std::get<Is>(this->_m_pat), std::forward<Ts>(std::get<Is>(_tup)))...)};
-
-            if ((std::get<Is>(_binders) && ...))
-                return std::optional{std::tuple_cat(std::move(*std::get<Is>(_binders))...)};
-            else
-                return std::nullopt;
+            return _detail::_element_match<std::tuple<Pats...>, Tuple>::match(this->_m_pat, std::forward<Tuple>(_tup));
         }
 
-        template <cxx_patterns::tuple_like Tuple>
-        constexpr auto match(Tuple &&_tup) const noexcept(noexcept(this->_match_impl(cxx_patterns::forward_to_tuple(std::forward<Tuple>(_tup)), std::make_index_sequence<std::tuple_size_v<Tuple>>{})))
-            -> decltype(this->_match_impl(cxx_patterns::forward_to_tuple(std::forward<Tuple>(_tup)), std::make_index_sequence<std::tuple_size_v<Tuple>>{}))
+        /// @brief The pattern being matched, for dispatch strategies that have already decided part of the match
+        constexpr const std::tuple<Pats...> &pattern() const noexcept
         {
-            return this->_match_impl(cxx_patterns::forward_to_tuple(std::forward<Tuple>(_tup)), std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+            return this->_m_pat;
         }
     };
 
@@ -107,9 +114,9 @@ namespace cxx_patterns
         F _m_arm;
 
         template <typename Self, typename T>
-            requires cxx_patterns::matchable<Pat, T, cxx_patterns::forward_cvref_t<F, Self>> && (!_detail::_matchable_void<Pat, T, cxx_patterns::forward_cvref_t<F, Self>>)
+            requires cxx_patterns::matchable<cxx_patterns::matcher<Pat>, T, cxx_patterns::forward_cvref_t<F, Self>> && (!_detail::_matchable_void<cxx_patterns::matcher<Pat>, T, cxx_patterns::forward_cvref_t<F, Self>>)
         constexpr auto
-        operator()(this Self &&self, T &&t) noexcept((cxx_patterns::noexcept_pattern<Pat, T> && cxx_patterns::noexcept_applyable<cxx_patterns::forward_cvref_t<F, Self>, cxx_patterns::pattern_outputs_t<Pat, T>>))
+        operator()(this Self &&self, T &&t) noexcept((cxx_patterns::noexcept_pattern<cxx_patterns::matcher<Pat>, T> && cxx_patterns::noexcept_applyable<cxx_patterns::forward_cvref_t<F, Self>, cxx_patterns::pattern_outputs_t<cxx_patterns::matcher<Pat>, T>>))
         {
             return cxx_patterns::match_pattern(self._m_pat, std::forward<T>(t))
                 .transform([&self](auto &&_tuple)
@@ -117,9 +124,9 @@ namespace cxx_patterns
         }
 
         template <typename Self, typename T>
-            requires cxx_patterns::matchable<Pat, T, cxx_patterns::forward_cvref_t<F, Self>> && _detail::_matchable_void<Pat, T, cxx_patterns::forward_cvref_t<F, Self>>
+            requires cxx_patterns::matchable<cxx_patterns::matcher<Pat>, T, cxx_patterns::forward_cvref_t<F, Self>> && _detail::_matchable_void<cxx_patterns::matcher<Pat>, T, cxx_patterns::forward_cvref_t<F, Self>>
         constexpr std::optional<_detail::_regular_void>
-        operator()(this Self &&self, T &&t) noexcept((cxx_patterns::noexcept_pattern<Pat, T> && cxx_patterns::noexcept_applyable<cxx_patterns::forward_cvref_t<F, Self>, cxx_patterns::pattern_outputs_t<Pat, T>>))
+        operator()(this Self &&self, T &&t) noexcept((cxx_patterns::noexcept_pattern<cxx_patterns::matcher<Pat>, T> && cxx_patterns::noexcept_applyable<cxx_patterns::forward_cvref_t<F, Self>, cxx_patterns::pattern_outputs_t<cxx_patterns::matcher<Pat>, T>>))
         {
             return cxx_patterns::match_pattern(self._m_pat, std::forward<T>(t))
                 .transform([&self](auto &&_tuple)
@@ -132,39 +139,516 @@ namespace cxx_patterns
 
     namespace _detail
     {
+        /// @brief The properties of an arm with pattern `Pat` and body `F` applied to a scrutinee of type `T`, computed once per arm.
+        /// Only defined if `matchable<matcher<Pat>, T, F &&>` is satisfied.
+        template <typename T, typename Pat, typename F>
+        struct _arm_traits
+        {
+        };
+
+        template <typename T, typename Pat, typename F>
+            requires cxx_patterns::matchable<cxx_patterns::matcher<Pat>, T, F &&>
+        struct _arm_traits<T, Pat, F>
+        {
+            using outputs = cxx_patterns::pattern_outputs_t<cxx_patterns::matcher<Pat>, T>;
+
+            using _body_result = cxx_patterns::apply_result_t<F &&, outputs>;
+
+            using result = std::conditional_t<std::is_void_v<_body_result>, _regular_void, std::remove_cvref_t<_body_result>>;
+
+            static constexpr bool nothrow{cxx_patterns::noexcept_pattern<cxx_patterns::matcher<Pat>, T> && cxx_patterns::noexcept_applyable<F &&, outputs>};
+        };
+
+        template <typename T, typename... M>
+        struct _match_result;
+
+        template <typename T, typename... Pat, typename... F>
+        struct _match_result<T, match_arm<Pat, F>...>
+        {
+            template <typename... Rs>
+            struct _common
+            {
+                using type = std::common_type_t<empty, Rs...>;
+            };
+
+            // `std::common_type` recurses once per type, so avoid it in the usual case where every arm has the same result type
+            template <typename R0, typename... Rs>
+                requires(std::same_as<R0, Rs> && ...)
+            struct _common<R0, Rs...>
+            {
+                using type = std::common_type_t<empty, R0>;
+            };
+
+            using type = typename _common<typename _arm_traits<T, Pat, F>::result...>::type;
+
+            static constexpr bool nothrow{(_arm_traits<T, Pat, F>::nothrow && ... && true)};
+        };
+
+        template <typename T, typename... M>
+        using _match_impl_return_type = typename _match_result<T, M...>::type;
+
+        template <std::size_t I, typename A>
+        struct _arm_pack_leaf
+        {
+            A &&_m_arm;
+        };
+
+        template <typename Seq, typename... A>
+        struct _arm_pack_impl;
+
+        template <std::size_t... Is, typename... A>
+        struct _arm_pack_impl<std::index_sequence<Is...>, A...> : _arm_pack_leaf<Is, A>...
+        {
+        };
+
+        /// @brief References to the arms of a `match` call, which can be accessed by index with `_arm_at`.
+        /// Unlike `std::tuple`, neither the pack nor an access to it requires a number of instantiations proportional to the number of arms.
+        template <typename... A>
+        using _arm_pack = _arm_pack_impl<std::index_sequence_for<A...>, A...>;
+
+        template <std::size_t I, typename A>
+        constexpr A &&_arm_at(const _arm_pack_leaf<I, A> &_leaf) noexcept
+        {
+            return std::forward<A>(_leaf._m_arm);
+        }
+
+        /// @brief Invokes the body of an arm whose pattern is already known to have matched, producing `_outputs`
+        template <typename R, typename F, typename Outputs>
+        constexpr R _invoke_arm_body(F &&_arm, Outputs &&_outputs)
+        {
+            if constexpr (std::is_void_v<cxx_patterns::apply_result_t<F &&, Outputs &&>>)
+            {
+                std::apply(std::forward<F>(_arm), std::forward<Outputs>(_outputs));
+                return R{};
+            }
+            else
+                return static_cast<R>(std::apply(std::forward<F>(_arm), std::forward<Outputs>(_outputs)));
+        }
+
+        /// @brief Tests one arm against the scrutinee, and if it matches, stores the result of its body in `_res` and returns `true`.
+        /// If `Likely` is `true`, the match is marked as the likely outcome.
+        template <typename R, bool Likely = false, typename T, typename Pat, typename F>
+        constexpr bool _try_arm(std::optional<R> &_res, match_arm<Pat, F> &&_arm, T &&_scrutinee) noexcept(_arm_traits<T, Pat, F>::nothrow && std::is_nothrow_convertible_v<typename _arm_traits<T, Pat, F>::result, R>)
+        {
+            auto _outputs = cxx_patterns::match_pattern(_arm._m_pat, std::forward<T>(_scrutinee));
+            if constexpr (Likely)
+            {
+                if (_outputs) [[likely]]
+                {
+                    _res.emplace(_detail::_invoke_arm_body<R>(std::move(_arm._m_arm), std::move(*_outputs)));
+                    return true;
+                }
+                else
+                    return false;
+            }
+            else if (_outputs)
+            {
+                _res.emplace(_detail::_invoke_arm_body<R>(std::move(_arm._m_arm), std::move(*_outputs)));
+                return true;
+            }
+            else
+                return false;
+        }
+
+        /// @brief Tests each arm in turn, and returns the result of the first that matches. At least one arm must match.
+        template <typename R, typename T, typename... Pat, typename... F>
+        R _match_fn_impl(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept((noexcept(_detail::_try_arm<R>(std::declval<std::optional<R> &>(), std::move(_arms), std::forward<T>(_scrutinee))) && ... && true))
+        {
+            std::optional<R> _res;
+            if ((_detail::_try_arm<R>(_res, std::move(_arms), std::forward<T>(_scrutinee)) || ...))
+                return std::move(*_res);
+            else
+                std::unreachable();
+        }
+
+        template <std::size_t I, typename Seq>
+        constexpr inline bool _index_in{false};
 
+        template <std::size_t I, std::size_t... Js>
+        constexpr inline bool _index_in<I, std::index_sequence<Js...>>{((I == Js) || ...)};
+
+        /// @brief As `_match_fn_impl`, but a match of each arm whose index is in `Likely` is marked as the likely outcome
+        template <typename R, typename Likely, std::size_t... Is, typename T, typename... Pat, typename... F>
+        R _match_fn_hinted(std::index_sequence<Is...>, T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept((noexcept(_detail::_try_arm<R>(std::declval<std::optional<R> &>(), std::move(_arms), std::forward<T>(_scrutinee))) && ... && true))
+        {
+            std::optional<R> _res;
+            if ((_detail::_try_arm<R, _index_in<Is, Likely>>(_res, std::move(_arms), std::forward<T>(_scrutinee)) || ...))
+                return std::move(*_res);
+            else
+                std::unreachable();
+        }
+
+        /// @brief The number of cases of each `switch` statement of `_switch_index`
+        constexpr inline std::size_t _switch_width{16};
+
+        /// @brief The number of indices covered by the outermost `switch` of `_switch_index` over `_n` indices: the smallest power of `_switch_width` that is at least `_n`
+        consteval std::size_t _switch_span(std::size_t _n) noexcept
+        {
+            std::size_t _span{_switch_width};
+            while (_span < _n)
+                _span *= _switch_width;
+            return _span;
+        }
+
+        /// @brief The first index covered by case `_k` of a `switch` of `_switch_index` over `_step` indices per case, starting at `_base`.
+        /// Cases past the last of `_n` indices are never taken, and repeat the last case that is, so that each of them names a valid index.
+        consteval std::size_t _switch_target(std::size_t _n, std::size_t _base, std::size_t _step, std::size_t _k) noexcept
+        {
+            return std::min(_base + _k * _step, _base + (_n - 1 - _base) / _step * _step);
+        }
+
+        /// @brief Returns `Case::template call<I>(_args...)` for the `I` equal to `_idx`, which must be less than `N`.
+        ///
+        /// The index is dispatched through nested `switch` statements of `_switch_width` cases, which compilers lower to jump tables,
+        ///  so that it takes constant time and, unlike a call through a table of function pointers, leaves each `Case::call` visible to the inliner.
+        /// `Case::call<I>` is named directly in the innermost `switch`, so that no template whose name mentions `Args` is instantiated once per index.
+        /// When `_args` include an `_arm_pack`, `Case::call<I>` can take the `_arm_pack_leaf` of arm `I`, so that its own name mentions only that arm.
+        template <typename R, typename Case, std::size_t N, std::size_t Base = 0, std::size_t Span = _switch_span(N), typename... Args>
+        constexpr R _switch_index(std::size_t _idx, Args &&..._args)
+        {
+            if constexpr (Span == _switch_width)
+            {
+                switch (_idx - Base)
+                {
+                case 0:
+                    return Case::template call<_switch_target(N, Base, 1, 0)>(std::forward<Args>(_args)...);
+                case 1:
+                    return Case::template call<_switch_target(N, Base, 1, 1)>(std::forward<Args>(_args)...);
+                case 2:
+                    return Case::template call<_switch_target(N, Base, 1, 2)>(std::forward<Args>(_args)...);
+                case 3:
+                    return Case::template call<_switch_target(N, Base, 1, 3)>(std::forward<Args>(_args)...);
+                case 4:
+                    return Case::template call<_switch_target(N, Base, 1, 4)>(std::forward<Args>(_args)...);
+                case 5:
+                    return Case::template call<_switch_target(N, Base, 1, 5)>(std::forward<Args>(_args)...);
+                case 6:
+                    return Case::template call<_switch_target(N, Base, 1, 6)>(std::forward<Args>(_args)...);
+                case 7:
+                    return Case::template call<_switch_target(N, Base, 1, 7)>(std::forward<Args>(_args)...);
+                case 8:
+                    return Case::template call<_switch_target(N, Base, 1, 8)>(std::forward<Args>(_args)...);
+                case 9:
+                    return Case::template call<_switch_target(N, Base, 1, 9)>(std::forward<Args>(_args)...);
+                case 10:
+                    return Case::template call<_switch_target(N, Base, 1, 10)>(std::forward<Args>(_args)...);
+                case 11:
+                    return Case::template call<_switch_target(N, Base, 1, 11)>(std::forward<Args>(_args)...);
+                case 12:
+                    return Case::template call<_switch_target(N, Base, 1, 12)>(std::forward<Args>(_args)...);
+                case 13:
+                    return Case::template call<_switch_target(N, Base, 1, 13)>(std::forward<Args>(_args)...);
+                case 14:
+                    return Case::template call<_switch_target(N, Base, 1, 14)>(std::forward<Args>(_args)...);
+                case 15:
+                    return Case::template call<_switch_target(N, Base, 1, 15)>(std::forward<Args>(_args)...);
+                default:
+                    std::unreachable();
+                }
+            }
+            else
+            {
+                constexpr std::size_t _step{Span / _switch_width};
+                switch ((_idx - Base) / _step)
+                {
+                case 0:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 0), _step>(_idx, std::forward<Args>(_args)...);
+                case 1:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 1), _step>(_idx, std::forward<Args>(_args)...);
+                case 2:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 2), _step>(_idx, std::forward<Args>(_args)...);
+                case 3:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 3), _step>(_idx, std::forward<Args>(_args)...);
+                case 4:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 4), _step>(_idx, std::forward<Args>(_args)...);
+                case 5:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 5), _step>(_idx, std::forward<Args>(_args)...);
+                case 6:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 6), _step>(_idx, std::forward<Args>(_args)...);
+                case 7:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 7), _step>(_idx, std::forward<Args>(_args)...);
+                case 8:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 8), _step>(_idx, std::forward<Args>(_args)...);
+                case 9:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 9), _step>(_idx, std::forward<Args>(_args)...);
+                case 10:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 10), _step>(_idx, std::forward<Args>(_args)...);
+                case 11:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 11), _step>(_idx, std::forward<Args>(_args)...);
+                case 12:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 12), _step>(_idx, std::forward<Args>(_args)...);
+                case 13:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 13), _step>(_idx, std::forward<Args>(_args)...);
+                case 14:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 14), _step>(_idx, std::forward<Args>(_args)...);
+                case 15:
+                    return _detail::_switch_index<R, Case, N, _switch_target(N, Base, _step, 15), _step>(_idx, std::forward<Args>(_args)...);
+                default:
+                    std::unreachable();
+                }
+            }
+        }
+
+        /// @brief The minimum number of leading constant arms for which `match` builds a lookup table instead of testing each arm in turn
+        constexpr inline std::size_t _constant_dispatch_threshold{4};
+
+        /// @brief The cases of the `_switch_index` of `_match_resolved_prefix`: invokes the body of arm `I`, whose pattern is already known to have matched.
+        /// Only arms whose patterns produce no outputs can be resolved this way, and only those are ever selected.
+        ///
+        /// Each case takes its arm as an `_arm_pack_leaf`, rather than the pack of all arms, so that the name of each instantiation mentions only one arm,
+        ///  and the total length of the symbols the compiler must mangle and record grows linearly rather than quadratically with the number of arms.
         template <typename R, typename T>
-        R _match_fn_impl(T &&_scrutinee) noexcept(true)
+        struct _resolved_case
+        {
+            template <std::size_t I, typename Pat, typename F>
+            static constexpr R call(const _arm_pack_leaf<I, match_arm<Pat, F>> &_leaf)
+            {
+                if constexpr (std::same_as<typename _arm_traits<T, Pat, F>::outputs, empty_matcher_t>)
+                    return _detail::_invoke_arm_body<R>(_detail::_arm_at(_leaf)._m_arm, empty_matcher_t{});
+                else
+                    std::unreachable();
+            }
+        };
+
+        /// @brief Finishes a `match` call whose first `K` arms have constant patterns, given `_idx`, the index of the first of those arms that matches the scrutinee (or `K` if none do).
+        template <typename R, std::size_t K, typename T, typename... Pat, typename... F>
+        R _match_resolved_prefix(std::size_t _idx, T &&_scrutinee, match_arm<Pat, F> &&..._arms)
+        {
+            const _arm_pack<match_arm<Pat, F>...> _pack{{std::move(_arms)}...};
+
+            if (_idx < K)
+                return _detail::_switch_index<R, _resolved_case<R, T>, K>(_idx, _pack);
+            else
+                return [&]<std::size_t... Js>(std::index_sequence<Js...>) -> R
+                {
+                    return _detail::_match_fn_impl<R>(std::forward<T>(_scrutinee), _detail::_arm_at<K + Js>(_pack)...);
+                }(std::make_index_sequence<sizeof...(Pat) - K>{});
+        }
+
+        /// @brief The cases of the `_switch_index` of `_match_variant_index`: case `J` tries in order the arms that can match alternative `J - 1`,
+        ///  and case 0 those that can match a valueless variant
+        template <typename R, typename T, typename... Pat>
+        struct _variant_case
+        {
+            template <std::size_t J, typename Pack>
+            static R call(T &&_scrutinee, const Pack &_pack)
+            {
+                return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> R
+                {
+                    return _detail::_match_fn_impl<R>(std::forward<T>(_scrutinee), _detail::_arm_at<Is>(_pack)...);
+                }(typename _alternative_candidates<T, J - 1, Pat...>::sequence{});
+            }
+        };
+
+        /// @brief Tests the arms of a `match` call on a `std::variant` by switching on `index()`, and only trying the arms that can match the active alternative.
+        template <typename R, typename T, typename... Pat, typename... F>
+        R _match_variant_index(T &&_scrutinee, match_arm<Pat, F> &&..._arms)
+        {
+            constexpr std::size_t _size{std::variant_size_v<std::remove_cvref_t<T>>};
+            const _arm_pack<match_arm<Pat, F>...> _pack{{std::move(_arms)}...};
+
+            // Index 0 is the valueless state, so that `std::variant_npos + 1` maps onto it
+            return _detail::_switch_index<R, _variant_case<R, T, Pat...>, _size + 1>(_scrutinee.index() + 1, std::forward<T>(_scrutinee), _pack);
+        }
+
+        /// @brief Tries an arm of a `match` call on a `kind_tagged` class hierarchy that the kind table selected as a candidate.
+        /// If the arm is an `instance_of` pattern decided by kind, the scrutinee is already known to be an instance, so it is downcast without reading its kind again.
+        template <typename R, typename T, typename Pat, typename F>
+        constexpr bool _try_kind_arm(std::optional<R> &_res, match_arm<Pat, F> &&_arm, T &&_scrutinee) noexcept(noexcept(_detail::_try_arm<R>(_res, std::move(_arm), std::forward<T>(_scrutinee))))
         {
+            if constexpr (_kind_pattern_for<T, Pat>)
+            {
+                if (auto _outputs = _detail::_match_known_instance(_arm._m_pat.pattern(), std::forward<T>(_scrutinee)))
+                {
+                    _res.emplace(_detail::_invoke_arm_body<R>(std::move(_arm._m_arm), std::move(*_outputs)));
+                    return true;
+                }
+                else
+                    return false;
+            }
+            else
+                return _detail::_try_arm<R>(_res, std::move(_arm), std::forward<T>(_scrutinee));
+        }
+
+        /// @brief The cases of the `_switch_index` of `_match_class_kind`: tries arm `I`, which the kind table selected as a candidate
+        template <typename R>
+        struct _kind_case
+        {
+            template <std::size_t I, typename A, typename T>
+            static constexpr bool call(const _arm_pack_leaf<I, A> &_leaf, std::optional<R> &_res, T &&_scrutinee)
+            {
+                return _detail::_try_kind_arm<R>(_res, _detail::_arm_at(_leaf), std::forward<T>(_scrutinee));
+            }
+        };
+
+        /// @brief Tests the arms of a `match` call on a `kind_tagged` class hierarchy by looking up the kind of the scrutinee once in an `_interval_table`,
+        ///  and only trying the arms that can match it.
+        template <typename R, typename T, typename... Pat, typename... F>
+        R _match_class_kind(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept((noexcept(_detail::_try_arm<R>(std::declval<std::optional<R> &>(), std::move(_arms), std::forward<T>(_scrutinee))) && ... && true))
+        {
+            using _table = _interval_table<_kind_key_t<T>, _kind_intervals<T, Pat...>>;
+
+            // A null pointer has no kind, and matches none of the `instance_of` arms
+            if constexpr (_hierarchy_scrutinee<T>::pointer)
+                if (_scrutinee == nullptr)
+                    return _detail::_match_fn_impl<R>(std::forward<T>(_scrutinee), std::move(_arms)...);
+
+            const _arm_pack<match_arm<Pat, F>...> _pack{{std::move(_arms)}...};
+            const _arm_mask<sizeof...(Pat)> &_candidates{_table::candidates(_detail::_kind_key_of<T>(_scrutinee))};
+
+            std::optional<R> _res;
+            for (std::size_t _i = _candidates.next(); _i < sizeof...(Pat); _i = _candidates.next(_i + 1))
+                if (_detail::_switch_index<bool, _kind_case<R>, sizeof...(Pat)>(_i, _pack, _res, std::forward<T>(_scrutinee)))
+                    return std::move(*_res);
+
             std::unreachable();
         }
 
-        template <typename T, typename... M>
-        using _match_impl_return_type = std::common_type_t<empty, typename _unwrap_optional<std::invoke_result_t<M, T &&>>::type...>;
+        /// @brief The cases of the `_switch_index` of `_match_tuple_tree`: tries arm `I`, which the `_tuple_tree` selected as a candidate.
+        /// A static arm is known to match, the other `std::tuple` arms only have their opaque columns tested, and any other arm is tested in full.
+        template <typename R, typename T, typename Tree>
+        struct _tuple_tree_case
+        {
+            template <std::size_t I, typename Pat, typename F>
+            static constexpr bool call(const _arm_pack_leaf<I, match_arm<Pat, F>> &_leaf, std::optional<R> &_res, typename Tree::_fields_t &_fields, T &&_scrutinee)
+            {
+                if constexpr (Tree::_s_static[I])
+                {
+                    _res.emplace(_detail::_invoke_arm_body<R>(_detail::_arm_at(_leaf)._m_arm, Tree::template outputs<I>(_fields)));
+                    return true;
+                }
+                else if constexpr (Tree::_s_tuple[I])
+                {
+                    if (auto _outputs = Tree::template match_unresolved<I>(_detail::_arm_at(_leaf)._m_pat.pattern(), _fields))
+                    {
+                        _res.emplace(_detail::_invoke_arm_body<R>(_detail::_arm_at(_leaf)._m_arm, std::move(*_outputs)));
+                        return true;
+                    }
+                    else
+                        return false;
+                }
+                else
+                    return _detail::_try_arm<R>(_res, _detail::_arm_at(_leaf), std::forward<T>(_scrutinee));
+            }
+        };
 
-        template <typename R, typename T, typename Pat1, typename F1, typename... Pat, typename... F>
-        R
-        _match_fn_impl(T &&_scrutinee, match_arm<Pat1, F1> &&_arm1, match_arm<Pat, F> &&..._arms) noexcept(std::is_nothrow_invocable_v<match_arm<Pat1, F1>, T &&> && (std::is_nothrow_invocable_v<match_arm<Pat, F>, T &&> && ...))
+        /// @brief Tests the arms of a `match` call on a `tuple_like` scrutinee using a `_tuple_tree`, which looks up each constrained field once to find the arms that may match.
+        template <typename R, typename T, typename... Pat, typename... F>
+        R _match_tuple_tree(T &&_scrutinee, match_arm<Pat, F> &&..._arms)
         {
-            if (auto _arm_match = _arm1(std::move(_scrutinee)))
-                return static_cast<R>(*_arm_match);
+            using _tree = _tuple_tree<T, Pat...>;
+
+            const _arm_pack<match_arm<Pat, F>...> _pack{{std::move(_arms)}...};
+            typename _tree::_fields_t _fields{cxx_patterns::forward_to_tuple(std::forward<T>(_scrutinee))};
+            const _arm_mask<sizeof...(Pat)> _candidates{_tree::candidates(_fields)};
+
+            std::optional<R> _res;
+            for (std::size_t _i = _candidates.next(); _i < sizeof...(Pat); _i = _candidates.next(_i + 1))
+                if (_detail::_switch_index<bool, _tuple_tree_case<R, T, _tree>, sizeof...(Pat)>(_i, _pack, _res, _fields, std::forward<T>(_scrutinee)))
+                    return std::move(*_res);
+
+            std::unreachable();
+        }
+
+        template <typename T, typename... Pat>
+        consteval bool _tuple_tree_dispatchable() noexcept
+        {
+            if constexpr (cxx_patterns::_tuple_like<T>)
+                return _tuple_tree<T, Pat...>::tuple_arms >= _constant_dispatch_threshold && _tuple_tree<T, Pat...>::indexed_columns != 0;
             else
-                return _match_fn_impl<R>(std::move(_scrutinee), std::move(_arms)...);
+                return false;
         }
 
+        /// @brief Selects how the arms of a `match` call are tested.
+        ///
+        /// If at least `_constant_dispatch_threshold` leading arms have constant patterns of one kind, they are resolved with a single table lookup,
+        ///  and the remaining arms are tried in order only if none of them match:
+        /// * For an integral scrutinee, `constant_interval_pattern` arms use an `_interval_table`.
+        /// * For a scrutinee convertible to a string view, `constant_string_pattern` arms use a `_string_table`.
+        ///
+        /// If the scrutinee is a `std::variant` and at least two arms use `alternative` patterns, `match` switches on the active alternative, and tries in order only the arms that can match it.
+        ///
+        /// If the scrutinee refers to a `kind_tagged` class hierarchy and at least two arms use `instance_of` patterns decided by kind, `match` looks up the kind of the scrutinee in an `_interval_table`,
+        ///  and tries in order only the arms that can match it.
+        ///
+        /// If the scrutinee is `tuple_like`, at least `_constant_dispatch_threshold` arms are `std::tuple` patterns, and some of them constrain a field with a `constant_interval_pattern`,
+        ///  `match` uses a `_tuple_tree`.
+        ///
+        /// Otherwise, each arm is tried in order, and a match of each arm whose index is in the `std::index_sequence` `Likely` is marked as the likely outcome.
+        template <typename R, typename Likely = std::index_sequence<>, typename T, typename... Pat, typename... F>
+        R _match_dispatch(T &&_scrutinee, match_arm<Pat, F> &&..._arms)
+        {
+            constexpr std::size_t _interval_prefix{_interval_scrutinee<T> ? _constant_interval_prefix<Pat...> : 0};
+            constexpr std::size_t _string_prefix{_constant_string_prefix<T, Pat...>};
+
+            if constexpr (_interval_prefix >= _constant_dispatch_threshold)
+            {
+                using _table = _interval_table<std::remove_cvref_t<T>, _prefix_intervals<std::remove_cvref_t<T>, _interval_prefix, Pat...>>;
+                return _detail::_match_resolved_prefix<R, _interval_prefix>(_table::first_match(_scrutinee), std::forward<T>(_scrutinee), std::move(_arms)...);
+            }
+            else if constexpr (_string_table_ok<(_string_prefix >= _constant_dispatch_threshold ? _string_prefix : 0), Pat...>)
+                return _detail::_match_resolved_prefix<R, _string_prefix>(_string_table<_string_prefix, Pat...>::first_match(_scrutinee), std::forward<T>(_scrutinee), std::move(_arms)...);
+            else if constexpr (_alternative_pattern_count<T, Pat...> >= 2)
+                return _detail::_match_variant_index<R>(std::forward<T>(_scrutinee), std::move(_arms)...);
+            else if constexpr (_kind_pattern_count<T, Pat...> >= 2)
+                return _detail::_match_class_kind<R>(std::forward<T>(_scrutinee), std::move(_arms)...);
+            else if constexpr (_detail::_tuple_tree_dispatchable<T, Pat...>())
+                return _detail::_match_tuple_tree<R>(std::forward<T>(_scrutinee), std::move(_arms)...);
+            else if constexpr (Likely::size() != 0)
+                return _detail::_match_fn_hinted<R, Likely>(std::index_sequence_for<Pat...>{}, std::forward<T>(_scrutinee), std::move(_arms)...);
+            else
+                return _detail::_match_fn_impl<R>(std::forward<T>(_scrutinee), std::move(_arms)...);
+        }
     }
 
+    /// @brief The policy used by `match` when none is given: arms are tested as described by `_match_dispatch`
+    struct default_match_policy
+    {
+        template <typename R, typename T, typename... Pat, typename... F>
+        static R dispatch(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(_detail::_match_result<T, match_arm<Pat, F>...>::nothrow)
+        {
+            return _detail::_match_dispatch<R>(std::forward<T>(_scrutinee), std::move(_arms)...);
+        }
+    };
+
+    /// @brief A concept for policies that control how `match<Policy>` tests its arms.
+    ///
+    /// A type `Policy` satisfies `match_policy<T, M...>` if `Policy::dispatch<R>(_scrutinee, _arms...)` is well-formed and returns `R`,
+    ///  where `R` is the result type of a `match` of a `T` against the arms `M...`.
+    /// `Policy` models `match_policy<T, M...>` only if the call returns the result of the body of the first arm whose pattern matches the scrutinee, as `default_match_policy` does.
+    template <typename Policy, typename T, typename... M>
+    concept match_policy = requires(T &&_scrutinee, M &&..._arms) {
+        { Policy::template dispatch<_detail::_match_impl_return_type<T, M...>>(std::forward<T>(_scrutinee), std::move(_arms)...) } -> std::same_as<_detail::_match_impl_return_type<T, M...>>;
+    };
+
     template <typename T, typename... Pat, typename... F>
-        requires(cxx_patterns::matchable<Pat, T, F &&> && ... && true) && (!std::same_as<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>, _detail::_regular_void>)
-    auto match(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept((std::is_nothrow_invocable_v<match_arm<Pat, F>, T &&> && ... && true))
+        requires(cxx_patterns::matchable<cxx_patterns::matcher<Pat>, T, F &&> && ... && true) && (!std::same_as<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>, _detail::_regular_void>)
+    auto match(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(_detail::_match_result<T, match_arm<Pat, F>...>::nothrow)
     {
-        return _detail::_match_fn_impl<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>>(std::forward<T>(_scrutinee), std::move(_arms)...);
+        return _detail::_match_dispatch<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>>(std::forward<T>(_scrutinee), std::move(_arms)...);
     }
 
     template <typename T, typename... Pat, typename... F>
-        requires(cxx_patterns::matchable<Pat, T, F &&> && ... && true) && (std::same_as<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>, _detail::_regular_void>)
-    void match(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept((std::is_nothrow_invocable_v<match_arm<Pat, F>, T &&> && ... && true))
+        requires(cxx_patterns::matchable<cxx_patterns::matcher<Pat>, T, F &&> && ... && true) && (std::same_as<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>, _detail::_regular_void>)
+    void match(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(_detail::_match_result<T, match_arm<Pat, F>...>::nothrow)
+    {
+        _detail::_match_dispatch<_detail::_regular_void>(std::forward<T>(_scrutinee), std::move(_arms)...);
+    }
+
+    /// @brief As `match(_scrutinee, _arms...)`, but `Policy` decides how the arms are tested, e.g. to record which arms match, or to test some of them first
+    template <typename Policy, typename T, typename... Pat, typename... F>
+        requires(cxx_patterns::matchable<cxx_patterns::matcher<Pat>, T, F &&> && ... && true) && (!std::same_as<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>, _detail::_regular_void>) &&
+                cxx_patterns::match_policy<Policy, T, match_arm<Pat, F>...>
+    auto match(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(noexcept(Policy::template dispatch<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>>(std::forward<T>(_scrutinee), std::move(_arms)...)))
+    {
+        return Policy::template dispatch<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>>(std::forward<T>(_scrutinee), std::move(_arms)...);
+    }
+
+    template <typename Policy, typename T, typename... Pat, typename... F>
+        requires(cxx_patterns::matchable<cxx_patterns::matcher<Pat>, T, F &&> && ... && true) && (std::same_as<_detail::_match_impl_return_type<T, match_arm<Pat, F>...>, _detail::_regular_void>) &&
+                cxx_patterns::match_policy<Policy, T, match_arm<Pat, F>...>
+    void match(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(noexcept(Policy::template dispatch<_detail::_regular_void>(std::forward<T>(_scrutinee), std::move(_arms)...)))
     {
-        _detail::_match_fn_impl<_detail::_regular_void>(std::forward<T>(_scrutinee), std::move(_arms)...);
+        Policy::template dispatch<_detail::_regular_void>(std::forward<T>(_scrutinee), std::move(_arms)...);
     }
 }
@@ -99,11 +99,12 @@ namespace cxx_patterns
         Pat _m_pat;
 
         template <typename T>
-        auto match(T &&_val) const noexcept(noexcept(cxx_patterns::noexcept_pattern<Pat, T>))
+        auto match(T &&_val) const noexcept(cxx_patterns::noexcept_pattern<Pat, T>)
+            -> std::optional<decltype(std::tuple_cat(std::forward_as_tuple(std::forward<T>(_val)), *cxx_patterns::match_pattern(this->_m_pat, std::forward<T>(_val))))>
             requires cxx_patterns::pattern<Pat, T>
         {
             if (auto _matched = cxx_patterns::match_pattern(this->_m_pat, std::forward<T>(_val)))
-                return std::optional{std::tuple_cat(std::forward_as_tuple(std::forward<T>()), cxx_patterns::forward_to_tuple(std::move(*_matched)))};
+                return std::tuple_cat(std::forward_as_tuple(std::forward<T>(_val)), std::move(*_matched));
             else
                 return std::nullopt;
         }
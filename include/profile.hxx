@@ -0,0 +1,358 @@
+#pragma once
+
+#include <match.hxx>
+#include <string-patterns.hxx>
+#include <integral-patterns.hxx>
+#include <class-patterns.hxx>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cxx_patterns
+{
+    /// @brief How often one arm of a profiled `match` call matched, and how often it was tested without matching
+    struct arm_counts
+    {
+        std::uint64_t hits;
+        std::uint64_t mismatches;
+    };
+
+    /// @brief The counts recorded by the `match` calls that use `profile<Site>`, summed over every thread that has executed them
+    struct site_profile
+    {
+        std::string_view site;
+        std::vector<arm_counts> arms;
+    };
+
+    namespace _detail
+    {
+        /// @brief The counters of one call site, shared by every thread that executes it.
+        /// Each thread counts into its own block of `2 * arms` counters (the hits of each arm, then the mismatches of each arm), which it attaches while it is running,
+        ///  and whose totals are kept when the thread exits.
+        class _profile_site
+        {
+        private:
+            std::string_view _m_name;
+            std::size_t _m_arms;
+            std::mutex _m_mutex;
+            std::vector<std::span<const std::atomic<std::uint64_t>>> _m_live;
+            std::vector<std::uint64_t> _m_retired;
+
+        public:
+            inline _profile_site(std::string_view _name, std::size_t _arms);
+
+            _profile_site(const _profile_site &) = delete;
+            _profile_site &operator=(const _profile_site &) = delete;
+
+            void attach(std::span<const std::atomic<std::uint64_t>> _counters)
+            {
+                std::lock_guard _lock{this->_m_mutex};
+                this->_m_live.push_back(_counters);
+            }
+
+            void detach(std::span<const std::atomic<std::uint64_t>> _counters)
+            {
+                std::lock_guard _lock{this->_m_mutex};
+                for (std::size_t _i = 0; _i < _counters.size(); _i++)
+                    this->_m_retired[_i] += _counters[_i].load(std::memory_order_relaxed);
+                std::erase_if(this->_m_live, [&](auto _live)
+                              { return _live.data() == _counters.data(); });
+            }
+
+            site_profile snapshot()
+            {
+                std::lock_guard _lock{this->_m_mutex};
+                std::vector<std::uint64_t> _totals{this->_m_retired};
+                for (auto _live : this->_m_live)
+                    for (std::size_t _i = 0; _i < _live.size(); _i++)
+                        _totals[_i] += _live[_i].load(std::memory_order_relaxed);
+
+                site_profile _profile{this->_m_name, std::vector<arm_counts>(this->_m_arms)};
+                for (std::size_t _i = 0; _i < this->_m_arms; _i++)
+                    _profile.arms[_i] = {_totals[_i], _totals[this->_m_arms + _i]};
+                return _profile;
+            }
+        };
+
+        /// @brief Every call site that has recorded a profile, in the order in which they were first executed
+        class _profile_registry
+        {
+        private:
+            std::mutex _m_mutex;
+            std::vector<_profile_site *> _m_sites;
+
+        public:
+            // Function-local, so that it is constructed before, and destroyed after, every `_profile_site`
+            static _profile_registry &instance()
+            {
+                static _profile_registry _s_registry;
+                return _s_registry;
+            }
+
+            void add(_profile_site *_site)
+            {
+                std::lock_guard _lock{this->_m_mutex};
+                this->_m_sites.push_back(_site);
+            }
+
+            std::vector<site_profile> snapshot()
+            {
+                std::lock_guard _lock{this->_m_mutex};
+                std::vector<site_profile> _profiles;
+                _profiles.reserve(this->_m_sites.size());
+                for (_profile_site *_site : this->_m_sites)
+                    _profiles.push_back(_site->snapshot());
+                return _profiles;
+            }
+        };
+
+        inline _profile_site::_profile_site(std::string_view _name, std::size_t _arms) : _m_name{_name}, _m_arms{_arms}, _m_retired(2 * _arms)
+        {
+            _profile_registry::instance().add(this);
+        }
+
+        template <basic_fixed_string Site, std::size_t N>
+        _profile_site &_profile_site_of()
+        {
+            static _profile_site _s_site{std::string_view{Site.data(), Site.size()}, N};
+            return _s_site;
+        }
+
+        /// @brief The counters of the current thread for the call site `Site`, which has `N` arms.
+        /// Only the owning thread writes them, so a count is a plain load and store rather than a locked read-modify-write.
+        template <basic_fixed_string Site, std::size_t N>
+        class _thread_profile
+        {
+        private:
+            std::array<std::atomic<std::uint64_t>, 2 * N> _m_counts{};
+            _profile_site &_m_site;
+
+            _thread_profile() : _m_site{_detail::_profile_site_of<Site, N>()}
+            {
+                this->_m_site.attach(this->_m_counts);
+            }
+
+            void _bump(std::atomic<std::uint64_t> &_count) noexcept
+            {
+                _count.store(_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+        public:
+            _thread_profile(const _thread_profile &) = delete;
+            _thread_profile &operator=(const _thread_profile &) = delete;
+
+            ~_thread_profile()
+            {
+                this->_m_site.detach(this->_m_counts);
+            }
+
+            static _thread_profile &current()
+            {
+                thread_local _thread_profile _s_profile;
+                return _s_profile;
+            }
+
+            void hit(std::size_t _arm) noexcept
+            {
+                this->_bump(this->_m_counts[_arm]);
+            }
+
+            void mismatch(std::size_t _arm) noexcept
+            {
+                this->_bump(this->_m_counts[N + _arm]);
+            }
+        };
+
+        /// @brief The `I`th type of `Ts...`, found without recursion
+        template <std::size_t I, typename... Ts>
+        using _type_at = std::remove_cvref_t<decltype(_detail::_arm_at<I>(std::declval<const _arm_pack<Ts...> &>()))>;
+
+        /// @brief Whether no value of type `T` can be matched by both `A` and `B`, as far as can be told from their types
+        template <typename T, typename A, typename B>
+        consteval bool _provably_disjoint() noexcept
+        {
+            if constexpr (_interval_scrutinee<T> && constant_interval_pattern<A> && constant_interval_pattern<B>)
+            {
+                constexpr _interval<std::remove_cvref_t<T>> _a{_detail::_interval_of<std::remove_cvref_t<T>, A>()};
+                constexpr _interval<std::remove_cvref_t<T>> _b{_detail::_interval_of<std::remove_cvref_t<T>, B>()};
+                return _a.empty || _b.empty || _a.upper < _b.lower || _b.upper < _a.lower;
+            }
+            else if constexpr (_kind_pattern_for<T, A> && _kind_pattern_for<T, B>)
+            {
+                constexpr _interval<_kind_key_t<T>> _a{_detail::_kind_interval_of<T, A>()};
+                constexpr _interval<_kind_key_t<T>> _b{_detail::_kind_interval_of<T, B>()};
+                return _a.empty || _b.empty || _a.upper < _b.lower || _b.upper < _a.lower;
+            }
+            else if constexpr (constant_string_pattern<A> && constant_string_pattern<B>)
+            {
+                if constexpr (std::same_as<decltype(A::value), decltype(B::value)>)
+                    return A::value != B::value;
+                else
+                    return false;
+            }
+            else
+                return false;
+        }
+
+        template <typename T, typename H, typename... Pat>
+        constexpr inline std::array<bool, sizeof...(Pat)> _disjoint_row{_detail::_provably_disjoint<T, H, Pat>()...};
+
+        template <typename T, typename Hints, typename... Pat>
+        struct _priority_plan;
+
+        /// @brief The order in which `prioritize<Is...>` tests the arms `Pat...`.
+        ///
+        /// Each hinted arm, in the order of `Is...`, is moved ahead of the arms that are not, if it is provably disjoint from every arm it would then be tested before, but was not before.
+        /// Moving such an arm cannot change which arm is the first to match. Every hinted arm, whether moved or not, is marked as likely to match.
+        template <typename T, std::size_t... Is, typename... Pat>
+        struct _priority_plan<T, std::index_sequence<Is...>, Pat...>
+        {
+            static constexpr std::size_t arms{sizeof...(Pat)};
+
+            static_assert(((Is < arms) && ... && true), "prioritize: arm index out of range");
+
+            struct _plan_t
+            {
+                std::array<std::size_t, arms> order;
+                std::array<std::size_t, arms> likely;
+                std::size_t likely_count;
+            };
+
+            static constexpr _plan_t _s_plan{[]
+                                             {
+                                                 constexpr std::array<std::size_t, sizeof...(Is)> _hints{Is...};
+                                                 // `_disjoint[k][a]`: whether arm `_hints[k]` is provably disjoint from arm `a`
+                                                 constexpr std::array<std::array<bool, arms>, sizeof...(Is)> _disjoint{_disjoint_row<T, _type_at<Is, Pat...>, Pat...>...};
+
+                                                 std::array<bool, arms> _hoisted{}, _hinted{};
+                                                 _plan_t _plan{};
+                                                 std::size_t _n{};
+                                                 for (std::size_t _k = 0; _k < _hints.size(); _k++)
+                                                 {
+                                                     const std::size_t _h{_hints[_k]};
+                                                     if (_hinted[_h])
+                                                         continue;
+                                                     _hinted[_h] = true;
+
+                                                     // The arms tested before `_h` that would be tested after it, and the hoisted arms tested after `_h` that would be tested before it
+                                                     bool _ok{true};
+                                                     for (std::size_t _a = 0; _a < arms; _a++)
+                                                         if ((_a < _h) != _hoisted[_a] && _a != _h && !_disjoint[_k][_a])
+                                                             _ok = false;
+                                                     if (_ok)
+                                                     {
+                                                         _hoisted[_h] = true;
+                                                         _plan.order[_n++] = _h;
+                                                     }
+                                                 }
+                                                 for (std::size_t _a = 0; _a < arms; _a++)
+                                                     if (!_hoisted[_a])
+                                                         _plan.order[_n++] = _a;
+
+                                                 for (std::size_t _p = 0; _p < arms; _p++)
+                                                     if (_hinted[_plan.order[_p]])
+                                                         _plan.likely[_plan.likely_count++] = _p;
+                                                 return _plan;
+                                             }()};
+
+            template <std::size_t... Ks>
+            static auto _likely_sequence(std::index_sequence<Ks...>) -> std::index_sequence<_s_plan.likely[Ks]...>;
+
+            /// @brief The positions, in the new order, of the hinted arms
+            using likely = decltype(_likely_sequence(std::make_index_sequence<_s_plan.likely_count>{}));
+        };
+    }
+
+    /// @brief Returns the counts recorded so far by every profiled call site, summed over all threads
+    inline std::vector<site_profile> profile_snapshot()
+    {
+        return _detail::_profile_registry::instance().snapshot();
+    }
+
+    /// @brief Writes the counts recorded so far by every profiled call site to `_out`, one arm per line,
+    ///  followed for each site by the `prioritize` policy that tests its arms that matched in decreasing order of hits
+    inline void dump_profile(std::ostream &_out)
+    {
+        for (const site_profile &_profile : cxx_patterns::profile_snapshot())
+        {
+            _out << std::format("{} ({} arms)\n", _profile.site, _profile.arms.size());
+            std::vector<std::size_t> _hot;
+            for (std::size_t _i = 0; _i < _profile.arms.size(); _i++)
+            {
+                _out << std::format("  arm {}: {} hits, {} mismatches\n", _i, _profile.arms[_i].hits, _profile.arms[_i].mismatches);
+                if (_profile.arms[_i].hits != 0)
+                    _hot.push_back(_i);
+            }
+            std::ranges::stable_sort(_hot, std::ranges::greater{}, [&](std::size_t _i)
+                                     { return _profile.arms[_i].hits; });
+
+            _out << "  suggested policy: cxx_patterns::prioritize<";
+            for (std::size_t _i = 0; _i < _hot.size(); _i++)
+                _out << (_i == 0 ? "" : ", ") << _hot[_i];
+            _out << ">\n";
+        }
+    }
+
+    /// @brief A `match` policy that records, for each arm, how often it matches and how often it is tested without matching,
+    ///  under the name `Site`, which should be unique to the call site.
+    ///
+    /// Counts are only recorded if `CXX_PATTERNS_PROFILE` is defined, consistently in every translation unit of the program; otherwise `profile<Site>` is equivalent to `default_match_policy`.
+    /// While recording, the arms are tested in order, so that every arm before the one that matches counts a mismatch; the dispatch tables used by `match` are not.
+    /// Each thread counts into its own counters, without synchronization; `profile_snapshot` and `dump_profile` sum them.
+    template <basic_fixed_string Site>
+        requires std::same_as<typename decltype(Site)::value_type, char>
+    struct profile
+    {
+#ifdef CXX_PATTERNS_PROFILE
+        template <typename R, typename T, typename... Pat, typename... F>
+        static R dispatch(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(_detail::_match_result<T, match_arm<Pat, F>...>::nothrow)
+        {
+            auto &_profile{_detail::_thread_profile<Site, sizeof...(Pat)>::current()};
+            std::optional<R> _res;
+            if ([&]<std::size_t... Is>(std::index_sequence<Is...>)
+                { return ((_detail::_try_arm<R>(_res, std::move(_arms), std::forward<T>(_scrutinee)) ? (_profile.hit(Is), true) : (_profile.mismatch(Is), false)) || ...); }(std::index_sequence_for<Pat...>{}))
+                return std::move(*_res);
+            else
+                std::unreachable();
+        }
+#else
+        template <typename R, typename T, typename... Pat, typename... F>
+        static R dispatch(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(_detail::_match_result<T, match_arm<Pat, F>...>::nothrow)
+        {
+            return _detail::_match_dispatch<R>(std::forward<T>(_scrutinee), std::move(_arms)...);
+        }
+#endif
+    };
+
+    /// @brief A `match` policy that tests the arms `Is...` (indices into the arms of the call, in decreasing order of expected frequency) first, where this cannot change the result.
+    ///
+    /// A hinted arm is tested before the others only if it is provably disjoint from every arm that it moves ahead of:
+    ///  both are `constant_interval_pattern`s whose intervals do not overlap within the scrutinee type, both are `instance_of` patterns decided by kind whose kind ranges do not overlap,
+    ///  or both are `constant_string_pattern`s with different values.
+    /// Arms that are tried in turn after the reordering, including hinted arms that could not be moved, have a match of each hinted arm marked as the likely outcome.
+    /// The reordered arms are otherwise dispatched as by `default_match_policy`, so a leading run of hinted constants still uses a dispatch table.
+    template <std::size_t... Is>
+    struct prioritize
+    {
+        template <typename R, typename T, typename... Pat, typename... F>
+        static R dispatch(T &&_scrutinee, match_arm<Pat, F> &&..._arms) noexcept(_detail::_match_result<T, match_arm<Pat, F>...>::nothrow)
+        {
+            using _plan = _detail::_priority_plan<T, std::index_sequence<Is...>, Pat...>;
+            const _detail::_arm_pack<match_arm<Pat, F>...> _pack{{std::move(_arms)}...};
+            return [&]<std::size_t... Ks>(std::index_sequence<Ks...>) -> R
+            { return _detail::_match_dispatch<R, typename _plan::likely>(std::forward<T>(_scrutinee), _detail::_arm_at<_plan::_s_plan.order[Ks]>(_pack)...); }(std::index_sequence_for<Pat...>{});
+        }
+    };
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <pattern-base.hxx>
+#include <string-patterns.hxx>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cxx_patterns
+{
+    namespace _detail
+    {
+        /// @brief Satisfied by the (possibly cv-qualified) types whose objects are single bytes of object representation
+        template <typename T>
+        concept _byte_like = std::same_as<std::remove_cv_t<T>, std::byte> || std::same_as<std::remove_cv_t<T>, char> || std::same_as<std::remove_cv_t<T>, signed char> ||
+                             std::same_as<std::remove_cv_t<T>, unsigned char> || std::same_as<std::remove_cv_t<T>, char8_t>;
+
+        template <typename T>
+        constexpr unsigned char _byte_value(T _byte) noexcept
+        {
+            return static_cast<unsigned char>(_byte);
+        }
+
+        /// @brief `true` if `Tuple` is a `std::tuple` that holds no references
+        template <typename Tuple>
+        constexpr inline bool _value_tuple{false};
+
+        template <typename... Ts>
+        constexpr inline bool _value_tuple<std::tuple<Ts...>>{(!std::is_reference_v<Ts> && ... && true)};
+
+        /// @brief Decodes a `V` from the `sizeof(V)` bytes at `_first`, stored with byte order `E`
+        template <typename V, std::endian E, typename T>
+        constexpr V _load_field(const T *_first) noexcept
+        {
+            if consteval
+            {
+                std::make_unsigned_t<V> _val{};
+                for (std::size_t _i = 0; _i < sizeof(V); _i++)
+                {
+                    const std::size_t _shift{E == std::endian::little ? _i : sizeof(V) - 1 - _i};
+                    _val |= static_cast<std::make_unsigned_t<V>>(static_cast<std::make_unsigned_t<V>>(_detail::_byte_value(_first[_i])) << (8 * _shift));
+                }
+                return static_cast<V>(_val);
+            }
+            else
+            {
+                V _val;
+                std::memcpy(&_val, _first, sizeof(V));
+                if constexpr (E != std::endian::native)
+                    _val = std::byteswap(_val);
+                return _val;
+            }
+        }
+    }
+
+    /// @brief A slice pattern part that matches the bytes of the compile-time string `Str`, not including its terminator
+    template <basic_fixed_string Str>
+        requires(sizeof(typename decltype(Str)::value_type) == 1)
+    struct magic
+    {
+        static constexpr std::size_t extent{Str.size()};
+        static constexpr bool is_rest{false};
+
+        template <_detail::_byte_like T>
+        constexpr std::optional<empty_matcher_t> match_at(const T *_first, std::size_t) const noexcept
+        {
+            bool _equal{true};
+            if consteval
+            {
+                for (std::size_t _i = 0; _i < extent; _i++)
+                    _equal = _equal && _detail::_byte_value(_first[_i]) == _detail::_byte_value(Str.data()[_i]);
+            }
+            else
+            {
+                _equal = std::memcmp(_first, Str.data(), extent) == 0;
+            }
+
+            if (_equal)
+                return empty_matcher;
+            else
+                return std::nullopt;
+        }
+    };
+
+    /// @brief A slice pattern part that decodes a `V` from `sizeof(V)` bytes stored with byte order `E`
+    ///
+    /// `field<V, E>` binds the decoded value. `field<V, E, Pat>` instead matches the decoded value against `Pat`, and produces the outputs of `Pat`,
+    ///  which must not refer to the decoded value (for example, `field<std::uint16_t, std::endian::big, constant<2>>`).
+    template <std::integral V, std::endian E = std::endian::native, typename Pat = void>
+        requires(!std::same_as<V, bool>) && (E == std::endian::big || E == std::endian::little)
+    struct field
+    {
+        static constexpr std::size_t extent{sizeof(V)};
+        static constexpr bool is_rest{false};
+
+        Pat _m_pat;
+
+        template <_detail::_byte_like T>
+            requires cxx_patterns::pattern<Pat, const V &> && _detail::_value_tuple<cxx_patterns::pattern_outputs_t<Pat, const V &>>
+        constexpr auto match_at(const T *_first, std::size_t) const noexcept(cxx_patterns::noexcept_pattern<Pat, const V &>)
+            -> std::optional<cxx_patterns::pattern_outputs_t<Pat, const V &>>
+        {
+            const V _val{_detail::_load_field<V, E>(_first)};
+            return cxx_patterns::match_pattern(this->_m_pat, _val);
+        }
+    };
+
+    template <std::integral V, std::endian E>
+        requires(!std::same_as<V, bool>) && (E == std::endian::big || E == std::endian::little)
+    struct field<V, E, void>
+    {
+        static constexpr std::size_t extent{sizeof(V)};
+        static constexpr bool is_rest{false};
+
+        template <_detail::_byte_like T>
+        constexpr std::optional<std::tuple<V>> match_at(const T *_first, std::size_t) const noexcept
+        {
+            return std::tuple<V>{_detail::_load_field<V, E>(_first)};
+        }
+    };
+
+    /// @brief A slice pattern part that matches one element. `element<>` binds a reference to the element, and `element<Pat>` matches the element against `Pat`.
+    template <typename Pat = void>
+    struct element
+    {
+        static constexpr std::size_t extent{1};
+        static constexpr bool is_rest{false};
+
+        Pat _m_pat;
+
+        template <typename T>
+            requires cxx_patterns::pattern<Pat, const T &>
+        constexpr auto match_at(const T *_first, std::size_t) const noexcept(cxx_patterns::noexcept_pattern<Pat, const T &>)
+            -> std::optional<cxx_patterns::pattern_outputs_t<Pat, const T &>>
+        {
+            return cxx_patterns::match_pattern(this->_m_pat, *_first);
+        }
+    };
+
+    template <>
+    struct element<void>
+    {
+        static constexpr std::size_t extent{1};
+        static constexpr bool is_rest{false};
+
+        template <typename T>
+        constexpr std::optional<std::tuple<const T &>> match_at(const T *_first, std::size_t) const noexcept
+        {
+            return std::forward_as_tuple(*_first);
+        }
+    };
+
+    /// @brief A slice pattern part that matches any `N` elements, and binds nothing
+    template <std::size_t N>
+    struct skip
+    {
+        static constexpr std::size_t extent{N};
+        static constexpr bool is_rest{false};
+
+        template <typename T>
+        constexpr std::optional<empty_matcher_t> match_at(const T *, std::size_t) const noexcept
+        {
+            return empty_matcher;
+        }
+    };
+
+    /// @brief A slice pattern part that matches all remaining elements (possibly none), and binds them as a `std::span` that refers to the scrutinee.
+    /// It may only appear as the last part of a `slice`.
+    struct rest
+    {
+        static constexpr std::size_t extent{0};
+        static constexpr bool is_rest{true};
+
+        template <typename T>
+        constexpr std::optional<std::tuple<std::span<const T>>> match_at(const T *_first, std::size_t _count) const noexcept
+        {
+            return std::tuple<std::span<const T>>{std::span<const T>{_first, _count}};
+        }
+    };
+
+    /// @brief A slice pattern part that matches all remaining elements (possibly none), and binds nothing. It may only appear as the last part of a `slice`.
+    struct ignore_rest
+    {
+        static constexpr std::size_t extent{0};
+        static constexpr bool is_rest{true};
+
+        template <typename T>
+        constexpr std::optional<empty_matcher_t> match_at(const T *, std::size_t) const noexcept
+        {
+            return empty_matcher;
+        }
+    };
+
+    /// @brief A concept for slice pattern parts
+    ///
+    /// A type `Part` satisfies `slice_part` if `Part::extent` is a constant expression of type `std::size_t` and `Part::is_rest` is a constant expression of type `bool`.
+    ///
+    /// A type `Part` models `slice_part<T>` for a given type `T` if `Part` satisfies `slice_part`, and given a const-qualified object `part` of type `Part`,
+    ///  a pointer `first` to the first of `n` consecutive objects of type `T` (with `n >= Part::extent`), and `n` itself, the call `part.match_at(first, n)` is equality preserving and returns `std::optional<Tuple>`,
+    ///  where `Tuple` models `tuple_access`. The call may only access the first `Part::extent` objects, or all `n` objects if `Part::is_rest` is `true`.
+    template <typename Part>
+    concept slice_part = requires {
+        requires std::same_as<std::remove_cv_t<decltype(Part::extent)>, std::size_t>;
+        requires std::same_as<std::remove_cv_t<decltype(Part::is_rest)>, bool>;
+        requires(Part::extent, Part::is_rest, true);
+    };
+
+    namespace _detail
+    {
+        template <typename Part, typename T>
+        concept _slice_part_for = slice_part<Part> && requires(const Part &_part, const T *_first, std::size_t _count) {
+            { _part.match_at(_first, _count) } -> _detail::_optional_of_tuple;
+        };
+
+        template <typename Part, typename T>
+        using _slice_part_outputs_t = typename decltype(std::declval<const Part &>().match_at(std::declval<const T *>(), std::size_t{}))::value_type;
+
+        template <typename Part, typename T>
+        constexpr inline bool _slice_part_nothrow{noexcept(std::declval<const Part &>().match_at(std::declval<const T *>(), std::size_t{}))};
+
+        /// @brief Satisfied if `R` is a contiguous, sized range whose elements are of type `T`
+        template <typename R>
+        concept _slice_scrutinee = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>;
+
+        template <typename R>
+        using _slice_element_t = std::remove_cv_t<std::ranges::range_value_t<R>>;
+    }
+
+    /// @brief A pattern that matches a contiguous range of elements against a sequence of fixed-width parts, optionally followed by a `rest` part.
+    ///
+    /// `slice<Parts...>` matches a contiguous, sized range whose elements are of type `T` (for example, `std::span<const std::byte>`), if each of `Parts` in turn matches the elements that follow the previous part.
+    /// Without a trailing `rest` or `ignore_rest` part, the range must have exactly as many elements as the parts consume.
+    /// The outputs are the outputs of each part, in order. Outputs that refer to elements, such as those of `element<>` and `rest`, refer to the scrutinee. Nothing is copied.
+    ///
+    /// The size of the range is checked once, before any part is matched. Each part is then matched at an offset known at compile time, and the parts after the first one that fails are not evaluated.
+    /// `magic` and `field` parts compare and load whole fields at a time.
+    template <slice_part... Parts>
+        requires(!(Parts::is_rest || ...) || (sizeof...(Parts) != 0 && std::tuple_element_t<sizeof...(Parts) - 1, std::tuple<Parts...>>::is_rest &&
+                                               (std::size_t{0} + ... + std::size_t{Parts::is_rest}) == 1))
+    struct slice
+    {
+        std::tuple<Parts...> _m_parts;
+
+        constexpr slice(Parts... _parts) : _m_parts{std::move(_parts)...}
+        {
+        }
+
+        /// @brief The number of elements consumed by the fixed-width parts
+        static constexpr std::size_t extent{(std::size_t{0} + ... + Parts::extent)};
+
+        static constexpr bool _s_open{(Parts::is_rest || ... || false)};
+
+        static constexpr std::array<std::size_t, sizeof...(Parts) + 1> _s_offsets{[]
+                                                                                   {
+                                                                                       std::array<std::size_t, sizeof...(Parts) + 1> _offsets{};
+                                                                                       constexpr std::size_t _extents[]{Parts::extent..., 0};
+                                                                                       for (std::size_t _i = 0; _i < sizeof...(Parts); _i++)
+                                                                                           _offsets[_i + 1] = _offsets[_i] + _extents[_i];
+                                                                                       return _offsets;
+                                                                                   }()};
+
+        template <typename T>
+        using outputs = decltype(std::tuple_cat(std::declval<_detail::_slice_part_outputs_t<Parts, T>>()...));
+
+        template <typename T>
+        static constexpr bool _s_nothrow{(_detail::_slice_part_nothrow<Parts, T> && ... && true)};
+
+        /// @brief Matches the parts from `I` onwards, given the outputs `_bound` of the parts before `I`
+        template <std::size_t I, typename T, typename Bound>
+        constexpr std::optional<outputs<T>> _match_from(const T *_first, std::size_t _size, Bound &&_bound) const noexcept(_s_nothrow<T>)
+        {
+            if constexpr (I == sizeof...(Parts))
+                return std::optional<outputs<T>>{std::in_place, std::forward<Bound>(_bound)};
+            else if (auto _matched = std::get<I>(this->_m_parts).match_at(_first + _s_offsets[I], _size - _s_offsets[I]))
+                return this->_match_from<I + 1>(_first, _size, std::tuple_cat(std::forward<Bound>(_bound), std::move(*_matched)));
+            else
+                return std::nullopt;
+        }
+
+        template <typename R>
+            requires _detail::_slice_scrutinee<R> && (_detail::_slice_part_for<Parts, _detail::_slice_element_t<R>> && ... && true)
+        constexpr auto match(R &&_val) const noexcept(_s_nothrow<_detail::_slice_element_t<R>>) -> std::optional<outputs<_detail::_slice_element_t<R>>>
+        {
+            const std::span<const _detail::_slice_element_t<R>> _elems{_val};
+
+            if (_s_open ? _elems.size() < extent : _elems.size() != extent)
+                return std::nullopt;
+
+            return this->_match_from<0>(_elems.data(), _elems.size(), std::tuple<>{});
+        }
+    };
+
+    template <typename... Parts>
+    slice(Parts...) -> slice<Parts...>;
+}
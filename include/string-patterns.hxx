@@ -0,0 +1,486 @@
+#pragma once
+
+#include <pattern-base.hxx>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace cxx_patterns
+{
+    /// @brief A string of `N` characters of type `CharT`, usable as a template argument
+    template <typename CharT, std::size_t N>
+    struct basic_fixed_string
+    {
+        using value_type = CharT;
+
+        CharT _m_data[N + 1]{};
+
+        consteval basic_fixed_string(const CharT (&_str)[N + 1]) noexcept
+        {
+            std::copy_n(_str, N + 1, this->_m_data);
+        }
+
+        static constexpr std::size_t size() noexcept
+        {
+            return N;
+        }
+
+        constexpr const CharT *data() const noexcept
+        {
+            return this->_m_data;
+        }
+    };
+
+    template <typename CharT, std::size_t N>
+    basic_fixed_string(const CharT (&)[N]) -> basic_fixed_string<CharT, N - 1>;
+
+    /// @brief A pattern that matches a string equal to the compile-time constant `Str`
+    ///
+    /// The pattern matches any value of type `std::basic_string_view<CharT, CharTraits>` (or convertible to it), where `CharT` is the character type of `Str`.
+    /// Because the string is part of the type, `cxx_patterns::match` can compile a run of `string_constant` arms into a perfect hash table.
+    template <basic_fixed_string Str, typename CharTraits = std::char_traits<typename decltype(Str)::value_type>>
+    struct string_constant
+    {
+        using char_type = typename decltype(Str)::value_type;
+        using traits_type = CharTraits;
+
+        static constexpr std::basic_string_view<char_type, traits_type> value{Str.data(), Str.size()};
+
+        constexpr std::optional<empty_matcher_t> match(std::basic_string_view<char_type, traits_type> _val) const noexcept
+        {
+            if (value == _val)
+                return empty_matcher;
+            else
+                return std::nullopt;
+        }
+    };
+
+    /// @brief A concept for patterns that match exactly one compile-time string
+    ///
+    /// A type `Pat` satisfies `constant_string_pattern` if `Pat::char_type` and `Pat::traits_type` name types,
+    ///  and `Pat::value` is a constant expression of type `std::basic_string_view<typename Pat::char_type, typename Pat::traits_type>`.
+    ///
+    /// A type `Pat` models `constant_string_pattern` if it satisfies `constant_string_pattern`, `Pat` models `pattern<std::basic_string_view<typename Pat::char_type, typename Pat::traits_type>>`,
+    ///  and matching a value `v` yields `empty_matcher` if `v == Pat::value`, and an empty optional otherwise.
+    template <typename Pat>
+    concept constant_string_pattern = requires {
+        typename Pat::char_type;
+        typename Pat::traits_type;
+        requires std::same_as<std::remove_cv_t<decltype(Pat::value)>, std::basic_string_view<typename Pat::char_type, typename Pat::traits_type>>;
+        requires(Pat::value.size(), true);
+    };
+
+    namespace _detail
+    {
+        template <typename View, typename Pat>
+        concept _constant_string_pattern_for = constant_string_pattern<Pat> && std::same_as<std::remove_cv_t<decltype(Pat::value)>, View>;
+
+        template <typename T, typename Pat0, typename... Pats>
+        consteval std::size_t _constant_string_prefix_impl() noexcept
+        {
+            if constexpr (constant_string_pattern<Pat0>)
+            {
+                using _view = std::remove_cv_t<decltype(Pat0::value)>;
+                if constexpr (std::convertible_to<T, _view>)
+                {
+                    constexpr bool _flags[]{true, _constant_string_pattern_for<_view, Pats>..., false};
+                    std::size_t _n{};
+                    while (_flags[_n])
+                        _n++;
+                    return _n;
+                }
+                else
+                    return 0;
+            }
+            else
+                return 0;
+        }
+
+        /// @brief The number of leading patterns in `Pats` that satisfy `constant_string_pattern` with the same string view type as the first, when `T` converts to that type
+        template <typename T, typename... Pats>
+        constexpr inline std::size_t _constant_string_prefix{[]
+                                                             {
+                                                                 if constexpr (sizeof...(Pats) == 0)
+                                                                     return std::size_t{0};
+                                                                 else
+                                                                     return _detail::_constant_string_prefix_impl<T, Pats...>();
+                                                             }()};
+
+        template <typename View, typename Pat>
+        constexpr View _string_key_of() noexcept
+        {
+            if constexpr (_constant_string_pattern_for<View, Pat>)
+                return Pat::value;
+            else
+                return View{};
+        }
+
+        /// @brief A compile-time perfect hash over the strings matched by the first `K` patterns of `Pats`
+        ///
+        /// At compile time, a small set of character positions is chosen such that the length together with the characters at those positions
+        ///  distinguishes every distinct string. For a small set of strings, a seed and power-of-two table size are then searched for which hashing those values is collision free,
+        ///  and a lookup hashes the scrutinee, reads a single slot, and performs one final comparison against the string in that slot.
+        /// Such a seed becomes exponentially harder to find as the number of strings grows, so larger sets hash to buckets of about two strings instead,
+        ///  and each bucket has a displacement, searched at compile time, that places its strings in free slots of a table with at least twice as many slots as strings.
+        /// A lookup then also reads the displacement of the scrutinee's bucket before reading its slot.
+        ///
+        /// If no perfect hash is found (which requires unusually many strings that differ only in many positions), `_s_ok` is false, and callers must test each pattern in turn.
+        template <std::size_t K, typename Pat0, typename... Pats>
+        struct _string_table
+        {
+            using view_type = std::remove_cv_t<decltype(Pat0::value)>;
+            using traits_type = typename view_type::traits_type;
+
+            static constexpr std::size_t arms = K;
+            static constexpr std::size_t _max_positions = 8;
+            static constexpr std::size_t _max_seeded_keys = 64;
+            static constexpr std::size_t _max_displacement = 1 << 16;
+
+            static constexpr std::array<view_type, K> _s_keys{[]
+                                                              {
+                                                                  constexpr std::array<view_type, sizeof...(Pats) + 1> _all{Pat0::value, _detail::_string_key_of<view_type, Pats>()...};
+                                                                  std::array<view_type, K> _keys{};
+                                                                  std::copy_n(_all.begin(), K, _keys.begin());
+                                                                  return _keys;
+                                                              }()};
+
+            /// @brief The number of slots of a displaced table
+            static constexpr std::size_t _s_displaced_size{std::bit_ceil(K) * 2};
+            static constexpr std::size_t _s_buckets{std::bit_ceil(K) / 2 + (K == 1)};
+
+            struct _positions_t
+            {
+                std::array<std::size_t, _max_positions> positions{};
+                std::size_t position_count{};
+                bool ok{};
+            };
+
+            /// @brief Where the keys are placed: by a seeded hash if `buckets` is zero, and by a displacement per bucket otherwise
+            struct _layout_t
+            {
+                std::uint64_t seed{};
+                std::size_t size{};
+                std::array<std::uint16_t, _s_buckets> displacements{};
+                std::size_t buckets{};
+                bool ok{};
+            };
+
+            static constexpr std::uint64_t _char_at(view_type _str, std::size_t _pos) noexcept
+            {
+                return _pos < _str.size() ? static_cast<std::uint64_t>(traits_type::to_int_type(_str[_pos])) : 0;
+            }
+
+            static constexpr std::uint64_t _mix(std::uint64_t _h) noexcept
+            {
+                _h = (_h ^ (_h >> 33)) * 0xff51afd7ed558ccd;
+                return _h ^ (_h >> 33);
+            }
+
+            static constexpr std::uint64_t _hash(view_type _str, const std::array<std::size_t, _max_positions> &_positions, std::size_t _count, std::uint64_t _seed = 0) noexcept
+            {
+                constexpr std::uint64_t _prime{0x100000001b3};
+                std::uint64_t _h{(0xcbf29ce484222325 ^ _seed) * _prime};
+                _h = (_h ^ _str.size()) * _prime;
+                for (std::size_t _i = 0; _i < _count; _i++)
+                    _h = (_h ^ _char_at(_str, _positions[_i])) * _prime;
+                // Keys often differ only in the low bits of a few characters, which the multiplications above only carry upwards, so fold the high bits back down
+                return _mix(_h);
+            }
+
+            static constexpr std::size_t _bucket_of(std::uint64_t _h) noexcept
+            {
+                return static_cast<std::size_t>(_h >> 32) & (_s_buckets - 1);
+            }
+
+            static constexpr std::size_t _displaced_slot(std::uint64_t _h, std::uint16_t _displacement) noexcept
+            {
+                return static_cast<std::size_t>(((_h ^ (_displacement * 0x9e3779b97f4a7c15)) * 0xff51afd7ed558ccd) >> (64 - std::countr_zero(_s_displaced_size)));
+            }
+
+            /// @brief Whether each key differs from every key before it. Later duplicates can never be the first match, so they are left out of the table.
+            static constexpr std::array<bool, K> _s_distinct{[]
+                                                             {
+                                                                 std::array<std::size_t, K> _order{};
+                                                                 for (std::size_t _i = 0; _i < K; _i++)
+                                                                     _order[_i] = _i;
+                                                                 std::sort(_order.begin(), _order.end(), [](std::size_t _a, std::size_t _b)
+                                                                           { return _s_keys[_a] != _s_keys[_b] ? _s_keys[_a] < _s_keys[_b] : _a < _b; });
+
+                                                                 std::array<bool, K> _distinct{};
+                                                                 for (std::size_t _k = 0; _k < K; _k++)
+                                                                     _distinct[_order[_k]] = _k == 0 || _s_keys[_order[_k - 1]] != _s_keys[_order[_k]];
+                                                                 return _distinct;
+                                                             }()};
+
+            static constexpr bool _first_occurrence(std::size_t _i) noexcept
+            {
+                return _s_distinct[_i];
+            }
+
+            /// @brief Sorts the first `_m` elements of `_classes`, and returns the number of pairs among them that are equal
+            static constexpr std::size_t _collisions(std::array<std::uint64_t, K> &_classes, std::size_t _m) noexcept
+            {
+                std::sort(_classes.begin(), _classes.begin() + _m);
+
+                std::size_t _n{};
+                std::size_t _run{1};
+                for (std::size_t _k = 1; _k < _m; _k++)
+                {
+                    if (_classes[_k - 1] != _classes[_k])
+                        _run = 1;
+                    else
+                        _n += _run++;
+                }
+                return _n;
+            }
+
+            /// @brief Pairs the class of a key with its character at `_pos`, so that keys get the same class only if they had the same class and agree at `_pos`
+            static constexpr std::uint64_t _refine(std::uint64_t _class, view_type _str, std::size_t _pos) noexcept
+            {
+                return (_class << 32) | (_char_at(_str, _pos) & 0xffffffff);
+            }
+
+            // The table is built in stages, each a separate constant expression, so that large tables stay within the compiler's limit on the cost of a single evaluation.
+
+            /// @brief Chooses the character positions to hash. `ok` is false if no small set of positions distinguishes every key.
+            static consteval _positions_t _choose_positions() noexcept
+            {
+                _positions_t _params{};
+
+                std::array<view_type, K> _distinct{};
+                std::size_t _m{};
+                std::size_t _max_len{};
+                for (std::size_t _i = 0; _i < K; _i++)
+                    if (_first_occurrence(_i))
+                    {
+                        _distinct[_m++] = _s_keys[_i];
+                        _max_len = std::max(_max_len, _s_keys[_i].size());
+                    }
+
+                // Keys start out in one class per length. Each chosen position splits the classes further, and the class ids are then renumbered densely so that they fit in 32 bits.
+                std::array<std::uint64_t, K> _classes{};
+                for (std::size_t _j = 0; _j < _m; _j++)
+                    _classes[_j] = _distinct[_j].size();
+
+                std::array<std::uint64_t, K> _scratch{_classes};
+                std::size_t _remaining{_collisions(_scratch, _m)};
+
+                // Greedily choose the positions that separate the most strings of equal length
+                while (_remaining != 0)
+                {
+                    if (_params.position_count == _max_positions)
+                        return _params;
+
+                    std::size_t _best_pos{};
+                    std::size_t _best{_remaining};
+                    for (std::size_t _pos = 0; _pos < _max_len; _pos++)
+                    {
+                        // A position at which every key has the same character cannot separate any of them, so skip the sort
+                        if (std::all_of(_distinct.begin(), _distinct.begin() + _m, [&](view_type _key)
+                                        { return _char_at(_key, _pos) == _char_at(_distinct[0], _pos); }))
+                            continue;
+
+                        for (std::size_t _j = 0; _j < _m; _j++)
+                            _scratch[_j] = _refine(_classes[_j], _distinct[_j], _pos);
+                        std::size_t _n{_collisions(_scratch, _m)};
+                        if (_n < _best)
+                        {
+                            _best = _n;
+                            _best_pos = _pos;
+                        }
+                    }
+
+                    if (_best == _remaining)
+                        return _params;
+
+                    for (std::size_t _j = 0; _j < _m; _j++)
+                        _scratch[_j] = _refine(_classes[_j], _distinct[_j], _best_pos);
+                    std::array<std::uint64_t, K> _ids{_scratch};
+                    std::sort(_ids.begin(), _ids.begin() + _m);
+                    for (std::size_t _j = 0; _j < _m; _j++)
+                        _classes[_j] = static_cast<std::uint64_t>(std::lower_bound(_ids.begin(), _ids.begin() + _m, _scratch[_j]) - _ids.begin());
+
+                    _params.positions[_params.position_count++] = _best_pos;
+                    _remaining = _best;
+                }
+
+                _params.ok = true;
+                return _params;
+            }
+
+            static constexpr _positions_t _s_positions{_choose_positions()};
+
+            /// @brief Searches for a seed for which hashing places every key in a different slot, in a table of up to 8 times as many slots as keys
+            static consteval _layout_t _place_seeded() noexcept
+            {
+                _layout_t _layout{};
+
+                for (std::size_t _size = std::bit_ceil(K); _size <= 8 * std::bit_ceil(K); _size *= 2)
+                    for (std::uint64_t _seed = 0; _seed < 256; _seed++)
+                    {
+                        std::array<bool, 8 * std::bit_ceil(K)> _used{};
+                        bool _ok{true};
+                        for (std::size_t _i = 0; _i < K && _ok; _i++)
+                        {
+                            if (!_first_occurrence(_i))
+                                continue;
+                            std::size_t _slot{static_cast<std::size_t>(_hash(_s_keys[_i], _s_positions.positions, _s_positions.position_count, _seed)) & (_size - 1)};
+                            _ok = !_used[_slot];
+                            _used[_slot] = true;
+                        }
+
+                        if (_ok)
+                        {
+                            _layout.seed = _seed;
+                            _layout.size = _size;
+                            _layout.ok = true;
+                            return _layout;
+                        }
+                    }
+
+                return _layout;
+            }
+
+            /// @brief Searches for a displacement for each bucket that places its keys in free slots. `ok` is false if some bucket cannot be placed.
+            static consteval _layout_t _place_displaced() noexcept
+            {
+                _layout_t _layout{};
+                _layout.size = _s_displaced_size;
+                _layout.buckets = _s_buckets;
+
+                std::array<std::uint64_t, K> _hashes{};
+                for (std::size_t _i = 0; _i < K; _i++)
+                    _hashes[_i] = _hash(_s_keys[_i], _s_positions.positions, _s_positions.position_count);
+
+                // Group the distinct keys by bucket
+                std::array<std::size_t, _s_buckets + 1> _starts{};
+                for (std::size_t _i = 0; _i < K; _i++)
+                    if (_first_occurrence(_i))
+                        _starts[_bucket_of(_hashes[_i]) + 1]++;
+                for (std::size_t _b = 0; _b < _s_buckets; _b++)
+                    _starts[_b + 1] += _starts[_b];
+
+                std::array<std::size_t, K> _members{};
+                std::array<std::size_t, _s_buckets> _fill{};
+                for (std::size_t _i = 0; _i < K; _i++)
+                    if (_first_occurrence(_i))
+                    {
+                        const std::size_t _b{_bucket_of(_hashes[_i])};
+                        _members[_starts[_b] + _fill[_b]++] = _i;
+                    }
+
+                // Place the largest buckets first, while the table is emptiest
+                std::array<std::size_t, _s_buckets> _order{};
+                for (std::size_t _b = 0; _b < _s_buckets; _b++)
+                    _order[_b] = _b;
+                std::sort(_order.begin(), _order.end(), [&](std::size_t _a, std::size_t _b)
+                          { return _starts[_a + 1] - _starts[_a] != _starts[_b + 1] - _starts[_b] ? _starts[_a + 1] - _starts[_a] > _starts[_b + 1] - _starts[_b] : _a < _b; });
+
+                std::array<bool, _s_displaced_size> _used{};
+                for (std::size_t _b : _order)
+                {
+                    if (_starts[_b] == _starts[_b + 1])
+                        break;
+
+                    bool _placed{false};
+                    for (std::size_t _d = 0; _d < _max_displacement && !_placed; _d++)
+                    {
+                        std::size_t _k{_starts[_b]};
+                        for (; _k < _starts[_b + 1]; _k++)
+                        {
+                            const std::size_t _slot{_displaced_slot(_hashes[_members[_k]], static_cast<std::uint16_t>(_d))};
+                            if (_used[_slot])
+                                break;
+                            _used[_slot] = true;
+                        }
+
+                        if (_k == _starts[_b + 1])
+                        {
+                            _layout.displacements[_b] = static_cast<std::uint16_t>(_d);
+                            _placed = true;
+                        }
+                        else
+                            for (std::size_t _j = _starts[_b]; _j < _k; _j++)
+                                _used[_displaced_slot(_hashes[_members[_j]], static_cast<std::uint16_t>(_d))] = false;
+                    }
+
+                    if (!_placed)
+                        return _layout;
+                }
+
+                _layout.ok = true;
+                return _layout;
+            }
+
+            static consteval _layout_t _place() noexcept
+            {
+                if (!_s_positions.ok)
+                    return {};
+
+                if constexpr (K <= _max_seeded_keys)
+                {
+                    _layout_t _seeded{_place_seeded()};
+                    if (_seeded.ok)
+                        return _seeded;
+                }
+
+                return _place_displaced();
+            }
+
+            static constexpr _layout_t _s_layout{_place()};
+
+            static constexpr bool _s_ok{_s_layout.ok};
+
+            using _index_t = std::conditional_t<(K < 255), std::uint8_t, std::conditional_t<(K < 65535), std::uint16_t, std::uint32_t>>;
+
+            static constexpr std::size_t _slot(view_type _str) noexcept
+            {
+                if constexpr (_s_layout.buckets == 0)
+                    return static_cast<std::size_t>(_hash(_str, _s_positions.positions, _s_positions.position_count, _s_layout.seed)) & (_s_layout.size - 1);
+                else
+                {
+                    const std::uint64_t _h{_hash(_str, _s_positions.positions, _s_positions.position_count)};
+                    return _displaced_slot(_h, _s_layout.displacements[_bucket_of(_h)]);
+                }
+            }
+
+            static constexpr std::array<_index_t, _s_layout.size> _s_slots{[]
+                                                                           {
+                                                                               std::array<_index_t, _s_layout.size> _slots{};
+                                                                               _slots.fill(static_cast<_index_t>(K));
+                                                                               for (std::size_t _i = 0; _i < K; _i++)
+                                                                                   if (_first_occurrence(_i))
+                                                                                       _slots[_slot(_s_keys[_i])] = static_cast<_index_t>(_i);
+                                                                               return _slots;
+                                                                           }()};
+
+            /// @brief Returns the index of the first pattern equal to `_val`, or `K` if there is none
+            static constexpr std::size_t first_match(view_type _val) noexcept
+                requires _s_ok
+            {
+                const std::size_t _idx{_s_slots[_slot(_val)]};
+                if (_idx < K && _s_keys[_idx] == _val)
+                    return _idx;
+                else
+                    return K;
+            }
+        };
+
+        /// @brief Whether a `_string_table` over the first `K` patterns of `Pats` could be built. False if `K` is zero.
+        template <std::size_t K, typename... Pats>
+        constexpr inline bool _string_table_ok{[]
+                                               {
+                                                   if constexpr (K == 0)
+                                                       return false;
+                                                   else
+                                                       return _string_table<K, Pats...>::_s_ok;
+                                               }()};
+    }
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <pattern-base.hxx>
+#include <integral-patterns.hxx>
+#include <interval-table.hxx>
+#include <tuple.hxx>
+#include <array>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cxx_patterns
+{
+    namespace _detail
+    {
+        template <typename T>
+        using _forwarded_tuple_t = decltype(cxx_patterns::forward_to_tuple(std::declval<T>()));
+
+        /// @brief Matches one element of a tuple pattern against a value of type `T`.
+        ///
+        /// Elements that are themselves `std::tuple`s are matched element-wise against a `tuple_like` value (as if by `matcher<std::tuple<...>>`),
+        ///  otherwise the element must be a `pattern<T>`. The specialization only defines `outputs` and `match` if the element can match `T`.
+        template <typename Pat, typename T>
+        struct _element_match
+        {
+        };
+
+        template <typename Pat, typename T>
+        concept _element_pattern = requires { typename _element_match<Pat, T>::outputs; };
+
+        template <typename PatTuple, typename T, typename = std::make_index_sequence<std::tuple_size_v<PatTuple>>>
+        constexpr inline bool _tuple_elements_match{false};
+
+        template <typename... Pats, typename T, std::size_t... Is>
+        constexpr inline bool _tuple_elements_match<std::tuple<Pats...>, T, std::index_sequence<Is...>>{(_element_pattern<Pats, std::tuple_element_t<Is, _forwarded_tuple_t<T>>> && ...)};
+
+        template <typename Pat, typename T>
+            requires cxx_patterns::pattern<Pat, T>
+        struct _element_match<Pat, T>
+        {
+            using outputs = cxx_patterns::pattern_outputs_t<Pat, T>;
+
+            static constexpr bool nothrow{cxx_patterns::noexcept_pattern<Pat, T>};
+
+            static constexpr std::optional<outputs> match(const Pat &_pat, T &&_val) noexcept(nothrow)
+            {
+                return cxx_patterns::match_pattern(_pat, std::forward<T>(_val));
+            }
+        };
+
+        template <typename... Pats, typename T>
+            requires(!cxx_patterns::pattern<std::tuple<Pats...>, T>) && cxx_patterns::_tuple_like<T> &&
+                    (sizeof...(Pats) == std::tuple_size_v<std::remove_cvref_t<T>>) && _tuple_elements_match<std::tuple<Pats...>, T>
+        struct _element_match<std::tuple<Pats...>, T>
+        {
+            using _fields_t = _forwarded_tuple_t<T>;
+
+            template <std::size_t I>
+            using _element = _element_match<std::tuple_element_t<I, std::tuple<Pats...>>, std::tuple_element_t<I, _fields_t>>;
+
+            template <typename Seq>
+            struct _elements;
+
+            template <std::size_t... Is>
+            struct _elements<std::index_sequence<Is...>>
+            {
+                using outputs = decltype(std::tuple_cat(std::declval<typename _element<Is>::outputs>()...));
+
+                static constexpr bool nothrow{(_element<Is>::nothrow && ...)};
+            };
+
+            using outputs = typename _elements<std::index_sequence_for<Pats...>>::outputs;
+
+            static constexpr bool nothrow{_elements<std::index_sequence_for<Pats...>>::nothrow};
+
+            /// @brief Matches the elements from `I` onwards, given the outputs `_bound` of the elements before `I`.
+            /// Stops at the first element that does not match, without evaluating the rest.
+            template <std::size_t I, typename Bound>
+            static constexpr std::optional<outputs> _match_from(const std::tuple<Pats...> &_pat, _fields_t &_fields, Bound &&_bound) noexcept(nothrow)
+            {
+                if constexpr (I == sizeof...(Pats))
+                    return std::optional<outputs>{std::in_place, std::forward<Bound>(_bound)};
+                else
+                {
+                    using _field = std::tuple_element_t<I, _fields_t>;
+
+                    if (auto _matched = _element<I>::match(std::get<I>(_pat), std::forward<_field>(std::get<I>(_fields))))
+                        return _match_from<I + 1>(_pat, _fields, std::tuple_cat(std::forward<Bound>(_bound), std::move(*_matched)));
+                    else
+                        return std::nullopt;
+                }
+            }
+
+            static constexpr std::optional<outputs> match(const std::tuple<Pats...> &_pat, T &&_val) noexcept(nothrow)
+            {
+                _fields_t _fields{cxx_patterns::forward_to_tuple(std::forward<T>(_val))};
+                return _match_from<0>(_pat, _fields, std::tuple<>{});
+            }
+        };
+
+        enum class _column_kind
+        {
+            _opaque,
+            _interval,
+            _wildcard,
+        };
+
+        /// @brief Describes how the arm pattern `Pat` constrains each field of a `tuple_like` scrutinee of type `T`.
+        ///
+        /// A column of a `std::tuple` pattern is an `_interval` if its pattern is a `constant_interval_pattern` on an integral field,
+        ///  a `_wildcard` if its pattern is `binding<>`, and `_opaque` otherwise. Every column of a pattern that is not a `std::tuple` of the right size is `_opaque`.
+        template <typename T, typename Pat>
+        struct _tuple_arm_columns
+        {
+            static constexpr std::size_t _s_size{std::tuple_size_v<std::remove_cvref_t<T>>};
+
+            static constexpr bool is_tuple{false};
+
+            static constexpr std::array<_column_kind, _s_size> kinds{};
+
+            template <std::size_t C, typename Field>
+            static constexpr _interval<Field> interval() noexcept
+            {
+                return {std::numeric_limits<Field>::min(), std::numeric_limits<Field>::max(), false};
+            }
+        };
+
+        template <typename T, typename... Pats>
+            requires(sizeof...(Pats) == std::tuple_size_v<std::remove_cvref_t<T>>)
+        struct _tuple_arm_columns<T, std::tuple<Pats...>>
+        {
+            template <typename P, typename Field>
+            static consteval _column_kind _kind_of() noexcept
+            {
+                if constexpr (constant_interval_pattern<P> && _interval_scrutinee<Field>)
+                    return _column_kind::_interval;
+                else if constexpr (std::same_as<P, binding<void>>)
+                    return _column_kind::_wildcard;
+                else
+                    return _column_kind::_opaque;
+            }
+
+            static constexpr bool is_tuple{true};
+
+            static constexpr std::array<_column_kind, sizeof...(Pats)> kinds{[]<std::size_t... Is>(std::index_sequence<Is...>)
+                                                                             { return std::array<_column_kind, sizeof...(Pats)>{_kind_of<Pats, std::tuple_element_t<Is, _forwarded_tuple_t<T>>>()...}; }(std::index_sequence_for<Pats...>{})};
+
+            template <std::size_t C, typename Field>
+            static constexpr _interval<Field> interval() noexcept
+            {
+                using _pat = std::tuple_element_t<C, std::tuple<Pats...>>;
+                if constexpr (kinds[C] == _column_kind::_interval)
+                    return _detail::_interval_of<Field, _pat>();
+                else
+                    return {std::numeric_limits<Field>::min(), std::numeric_limits<Field>::max(), false};
+            }
+        };
+
+        /// @brief A decision procedure for a list of arm patterns `Pats` over a `tuple_like` scrutinee of type `T`.
+        ///
+        /// Each field that some arm constrains with a `constant_interval_pattern` is looked up once in an `_interval_table`, which yields the set of arms that accept that field.
+        /// Intersecting these sets gives the arms that can still match, in order. An arm whose columns are all intervals or `binding<>` is then known to match,
+        ///  and its outputs are formed directly from the fields. Any other `std::tuple` arm only has its opaque columns tested when it is reached,
+        ///  and an arm that is not a `std::tuple` is tested in full.
+        template <typename T, typename... Pats>
+        struct _tuple_tree
+        {
+            using _fields_t = _forwarded_tuple_t<T>;
+
+            static constexpr std::size_t arms{sizeof...(Pats)};
+            static constexpr std::size_t _s_columns{std::tuple_size_v<std::remove_cvref_t<T>>};
+
+            template <std::size_t C>
+            using _field_t = std::remove_cvref_t<std::tuple_element_t<C, _fields_t>>;
+
+            static constexpr std::size_t tuple_arms{(std::size_t{0} + ... + std::size_t{_tuple_arm_columns<T, Pats>::is_tuple})};
+
+            static constexpr std::array<bool, _s_columns> _s_indexed{[]
+                                                                     {
+                                                                         std::array<bool, _s_columns> _indexed{};
+                                                                         for (std::size_t _c = 0; _c < _s_columns; _c++)
+                                                                             _indexed[_c] = ((_tuple_arm_columns<T, Pats>::kinds[_c] == _column_kind::_interval) || ...);
+                                                                         return _indexed;
+                                                                     }()};
+
+            static constexpr std::size_t indexed_columns{static_cast<std::size_t>(std::ranges::count(_s_indexed, true))};
+
+            template <std::size_t I>
+            using _arm_pattern_t = std::tuple_element_t<I, std::tuple<Pats...>>;
+
+            template <std::size_t I>
+            using _arm_outputs_t = typename _element_match<_arm_pattern_t<I>, T>::outputs;
+
+            static constexpr std::array<bool, arms> _s_tuple{_tuple_arm_columns<T, Pats>::is_tuple...};
+
+            static constexpr std::array<bool, arms> _s_static{[]
+                                                              {
+                                                                  return std::array<bool, arms>{(_tuple_arm_columns<T, Pats>::is_tuple && std::ranges::none_of(_tuple_arm_columns<T, Pats>::kinds, [](_column_kind _k)
+                                                                                                                                                               { return _k == _column_kind::_opaque; }))...};
+                                                              }()};
+
+            template <std::size_t C>
+            using _column_table = _interval_table<_field_t<C>, std::array<_interval<_field_t<C>>, arms>{_tuple_arm_columns<T, Pats>::template interval<C, _field_t<C>>()...}>;
+
+            static constexpr _arm_mask<arms> _s_all{[]
+                                                    {
+                                                        _arm_mask<arms> _all{};
+                                                        for (std::size_t _i = 0; _i < arms; _i++)
+                                                            _all.set(_i);
+                                                        return _all;
+                                                    }()};
+
+            /// @brief Returns the set of arms that may match the scrutinee with fields `_fields`, looking up each indexed field once
+            static constexpr _arm_mask<arms> candidates(_fields_t &_fields) noexcept
+            {
+                _arm_mask<arms> _mask{_s_all};
+                [&]<std::size_t... Cs>(std::index_sequence<Cs...>)
+                {
+                    ([&]
+                     {
+                        if constexpr (_s_indexed[Cs])
+                            _mask &= _column_table<Cs>::candidates(std::get<Cs>(_fields)); }(),
+                     ...);
+                }(std::make_index_sequence<_s_columns>{});
+                return _mask;
+            }
+
+            /// @brief Matches the columns of arm `I` from `C` onwards, given the outputs `_bound` of the columns before `C`.
+            /// Interval columns were decided by `candidates`, and wildcard columns bind their field, so only opaque columns are tested.
+            template <std::size_t I, std::size_t C, typename Bound>
+            static constexpr std::optional<_arm_outputs_t<I>> _match_opaque_from(const _arm_pattern_t<I> &_pat, _fields_t &_fields, Bound &&_bound) noexcept(_element_match<_arm_pattern_t<I>, T>::nothrow)
+            {
+                using _columns = _tuple_arm_columns<T, _arm_pattern_t<I>>;
+
+                if constexpr (C == _s_columns)
+                    return std::optional<_arm_outputs_t<I>>{std::in_place, std::forward<Bound>(_bound)};
+                else
+                {
+                    using _field = std::tuple_element_t<C, _fields_t>;
+
+                    if constexpr (_columns::kinds[C] == _column_kind::_interval)
+                        return _match_opaque_from<I, C + 1>(_pat, _fields, std::forward<Bound>(_bound));
+                    else if constexpr (_columns::kinds[C] == _column_kind::_wildcard)
+                        return _match_opaque_from<I, C + 1>(_pat, _fields, std::tuple_cat(std::forward<Bound>(_bound), std::forward_as_tuple(std::forward<_field>(std::get<C>(_fields)))));
+                    else if (auto _matched = _element_match<std::tuple_element_t<C, _arm_pattern_t<I>>, _field>::match(std::get<C>(_pat), std::forward<_field>(std::get<C>(_fields))))
+                        return _match_opaque_from<I, C + 1>(_pat, _fields, std::tuple_cat(std::forward<Bound>(_bound), std::move(*_matched)));
+                    else
+                        return std::nullopt;
+                }
+            }
+
+            /// @brief Matches `_pat`, the pattern of arm `I`, which must be a `std::tuple` arm among the `candidates` for the scrutinee with fields `_fields`, by testing only its opaque columns
+            template <std::size_t I>
+            static constexpr std::optional<_arm_outputs_t<I>> match_unresolved(const _arm_pattern_t<I> &_pat, _fields_t &_fields) noexcept(_element_match<_arm_pattern_t<I>, T>::nothrow)
+            {
+                return _match_opaque_from<I, 0>(_pat, _fields, std::tuple<>{});
+            }
+
+            /// @brief The outputs of arm `I`, which must be static, given that it matches the scrutinee with fields `_fields`
+            template <std::size_t I>
+            static constexpr auto outputs(_fields_t &_fields) noexcept
+            {
+                using _columns = _tuple_arm_columns<T, std::tuple_element_t<I, std::tuple<Pats...>>>;
+                return [&]<std::size_t... Cs>(std::index_sequence<Cs...>)
+                {
+                    return std::tuple_cat([&]
+                                          {
+                                              if constexpr (_columns::kinds[Cs] == _column_kind::_wildcard)
+                                                  return std::forward_as_tuple(std::forward<std::tuple_element_t<Cs, _fields_t>>(std::get<Cs>(_fields)));
+                                              else
+                                                  return empty_matcher_t{};
+                                          }()...);
+                }(std::make_index_sequence<_s_columns>{});
+            }
+        };
+    }
+}
@@ -55,7 +55,7 @@ namespace cxx_patterns
         };
 
         template <typename Tuple, std::size_t... I>
-        constexpr std::tuple<forward_cvref_t<std::tuple_element_t<I, Tuple>, Tuple &&>...>
+        constexpr std::tuple<forward_cvref_t<std::tuple_element_t<I, std::remove_cvref_t<Tuple>>, Tuple &&>...>
         _to_tuple_impl(Tuple &&t, std::index_sequence<I...>) noexcept
         {
             return std::forward_as_tuple(_get<I>(std::forward<Tuple>(t))...);
@@ -82,7 +82,7 @@ namespace cxx_patterns
 
     template <typename Tuple>
     concept _tuple_like = requires {
-        { auto(std::tuple_size_v<std::remove_cvref_t<Tuple>>) } -> std::unsigned_integral;
+        { auto(std::tuple_size<std::remove_cvref_t<Tuple>>::value) } -> std::unsigned_integral;
     };
 
     /// @brief a Concept for types that provide a tuple-like interface.
@@ -113,7 +113,7 @@ namespace cxx_patterns
     template <_tuple_like Tuple>
     decltype(auto) forward_to_tuple(Tuple &&tuple) noexcept
     {
-        return _detail::_to_tuple_impl(std::forward<Tuple>(tuple), std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+        return _detail::_to_tuple_impl(std::forward<Tuple>(tuple), std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<Tuple>>>{});
     }
 
     template <typename T, std::size_t N>
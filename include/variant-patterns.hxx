@@ -0,0 +1,143 @@
+#pragma once
+
+#include <pattern-base.hxx>
+#include <type-traits.hxx>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace cxx_patterns
+{
+    namespace _detail
+    {
+        template <typename V>
+        struct _variant_traits
+        {
+        };
+
+        template <typename... Ts>
+        struct _variant_traits<std::variant<Ts...>>
+        {
+            template <typename T>
+            static constexpr std::size_t index_of{[]
+                                                  {
+                                                      constexpr bool _same[]{std::same_as<T, Ts>...};
+                                                      std::size_t _idx{std::variant_npos};
+                                                      for (std::size_t _i = 0; _i < sizeof...(Ts); _i++)
+                                                          if (_same[_i])
+                                                          {
+                                                              if (_idx != std::variant_npos)
+                                                                  return std::variant_npos;
+                                                              _idx = _i;
+                                                          }
+                                                      return _idx;
+                                                  }()};
+        };
+
+        /// @brief Satisfied if `std::remove_cvref_t<V>` is a specialization of `std::variant` that holds `T` exactly once
+        template <typename V, typename T>
+        concept _variant_holding = requires {
+            requires _variant_traits<std::remove_cvref_t<V>>::template index_of<T> != std::variant_npos;
+        };
+    }
+
+    /// @brief A pattern that matches a `std::variant` whose active alternative is of type `T`
+    ///
+    /// `alternative<T>` matches a `std::variant` `v` that holds `T` exactly once, and binds a reference to the active member,
+    ///  with the same value category and cv-qualification as `v`. The active member is never copied.
+    ///
+    /// `alternative<T, Pat>` additionally matches the active member against `Pat`, and produces the outputs of `Pat`.
+    /// Use `alternative<T, binding<Pat>>` to bind the active member and apply `Pat` to it.
+    ///
+    /// When at least two arms of a `cxx_patterns::match` call use `alternative` patterns on a `std::variant` scrutinee, `match` switches on `index()`
+    ///  and only tests the arms that can match the active alternative.
+    template <typename T, typename Pat = void>
+    struct alternative
+    {
+        using alternative_type = T;
+
+        Pat _m_pat;
+
+        template <typename V>
+            requires _detail::_variant_holding<V, T> && cxx_patterns::pattern<Pat, forward_cvref_t<T, V &&>>
+        constexpr auto match(V &&_val) const noexcept(cxx_patterns::noexcept_pattern<Pat, forward_cvref_t<T, V &&>>)
+            -> std::optional<cxx_patterns::pattern_outputs_t<Pat, forward_cvref_t<T, V &&>>>
+        {
+            if (auto *_alt = std::get_if<T>(&_val))
+                return cxx_patterns::match_pattern(this->_m_pat, static_cast<forward_cvref_t<T, V &&>>(*_alt));
+            else
+                return std::nullopt;
+        }
+    };
+
+    template <typename T>
+    struct alternative<T, void>
+    {
+        using alternative_type = T;
+
+        template <typename V>
+            requires _detail::_variant_holding<V, T>
+        constexpr std::optional<std::tuple<forward_cvref_t<T, V &&>>> match(V &&_val) const noexcept
+        {
+            if (auto *_alt = std::get_if<T>(&_val))
+                return std::forward_as_tuple(static_cast<forward_cvref_t<T, V &&>>(*_alt));
+            else
+                return std::nullopt;
+        }
+    };
+
+    namespace _detail
+    {
+        template <typename Pat>
+        concept _alternative_pattern = requires { typename Pat::alternative_type; };
+
+        template <typename V, typename Pat>
+        concept _alternative_pattern_for = _alternative_pattern<Pat> && _variant_holding<V, typename Pat::alternative_type>;
+
+        /// @brief The number of patterns in `Pats` that are `alternative` patterns for the variant `V`. Zero if `V` is not a variant.
+        template <typename V, typename... Pats>
+        constexpr inline std::size_t _alternative_pattern_count{(std::size_t{0} + ... + std::size_t{_alternative_pattern_for<V, Pats>})};
+
+        template <typename V, std::size_t J, typename Pat>
+        consteval bool _may_match_alternative() noexcept
+        {
+            if constexpr (_alternative_pattern<Pat>)
+                return J != std::variant_npos && _variant_traits<std::remove_cvref_t<V>>::template index_of<typename Pat::alternative_type> == J;
+            else
+                return true;
+        }
+
+        /// @brief The indices of the patterns in `Pats` that can match a variant `V` whose active alternative has index `J` (or which is valueless, if `J` is `std::variant_npos`), in order
+        template <typename V, std::size_t J, typename... Pats>
+        struct _alternative_candidates
+        {
+            static constexpr std::array<bool, sizeof...(Pats)> _s_flags{_detail::_may_match_alternative<V, J, Pats>()...};
+
+            static constexpr std::size_t count{[]
+                                               {
+                                                   std::size_t _n{};
+                                                   for (bool _flag : _s_flags)
+                                                       _n += _flag;
+                                                   return _n;
+                                               }()};
+
+            static constexpr std::array<std::size_t, count> indices{[]
+                                                                    {
+                                                                        std::array<std::size_t, count> _indices{};
+                                                                        std::size_t _n{};
+                                                                        for (std::size_t _i = 0; _i < sizeof...(Pats); _i++)
+                                                                            if (_s_flags[_i])
+                                                                                _indices[_n++] = _i;
+                                                                        return _indices;
+                                                                    }()};
+
+            using sequence = decltype([]<std::size_t... Is>(std::index_sequence<Is...>)
+                                      { return std::index_sequence<indices[Is]...>{}; }(std::make_index_sequence<count>{}));
+        };
+    }
+}
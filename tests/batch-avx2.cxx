@@ -0,0 +1,100 @@
+// Built with -mavx2 (see the Makefile), so that the 32-byte kernels of batch.hxx are used for every lane width, including 64-bit lanes.
+// The Makefile only builds it on a host that supports AVX2, since any code in the file may use AVX2 instructions.
+#include <batch.hxx>
+
+#include "test-helper.hxx"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+template <auto V>
+using c = cxx_patterns::constant<V>;
+
+template <auto Lo, auto Hi>
+using r = cxx_patterns::inclusive_range<Lo, Hi>;
+
+#if !defined(CXX_PATTERNS_NO_SIMD) && defined(__AVX2__)
+constexpr bool avx2_build{true};
+static_assert(cxx_patterns::_detail::_simd_bytes == 32);
+#else
+constexpr bool avx2_build{false};
+#endif
+
+template <typename T, typename... Pats>
+constexpr bool vectorized{cxx_patterns::_detail::_batch_classifier_for<T, Pats...>::vectorized};
+
+template <typename T>
+std::vector<T> random_values(std::size_t _n)
+{
+    std::mt19937_64 _rng{_n};
+    std::vector<T> _vals(_n);
+    for (T &_val : _vals)
+        _val = static_cast<T>(_rng());
+    return _vals;
+}
+
+template <typename T, typename... Pats>
+std::size_t first_matching(T _val, const Pats &..._pats)
+{
+    std::size_t _idx{0};
+    static_cast<void>(((cxx_patterns::match_pattern(_pats, _val) ? true : (++_idx, false)) || ...));
+    return _idx;
+}
+
+// Checks `classify` and `partition_matches` against testing each pattern in turn
+template <typename T, typename... Pats>
+void check_kernel(const std::vector<T> &_vals, const Pats &..._pats)
+{
+    static_assert(!avx2_build || vectorized<T, Pats...>);
+
+    std::vector<std::uint8_t> _indices(_vals.size());
+    cxx_patterns::classify(_vals, _indices, _pats...);
+    for (std::size_t _i = 0; _i < _vals.size(); _i++)
+    {
+        const std::size_t _expected{first_matching(_vals[_i], _pats...)};
+        cxx_tests::test_assert(_indices[_i] == _expected, "element {} ({}) classified as {}, expected {}"sv, _i, static_cast<long long>(_vals[_i]), _indices[_i], _expected);
+    }
+
+    std::vector<T> _out(_vals.size());
+    const auto _offsets{cxx_patterns::partition_matches(_vals, _out, _pats...)};
+
+    std::vector<T> _expected;
+    for (std::size_t _arm = 0; _arm <= sizeof...(Pats); _arm++)
+    {
+        cxx_tests::test_assert(_offsets[_arm] == _expected.size(), "group {} starts at {}, expected {}"sv, _arm, _offsets[_arm], _expected.size());
+        std::ranges::copy_if(_vals, std::back_inserter(_expected), [&](T _val)
+                             { return first_matching(_val, _pats...) == _arm; });
+    }
+    cxx_tests::test_assert(_out == _expected, "unexpected partition of {} elements"sv, _vals.size());
+}
+
+void test_avx2_kernels()
+{
+    // Lengths that are not a multiple of any vector width exercise the scalar tail
+    check_kernel(random_values<std::int8_t>(1001), c<0>{}, r<-5, 5>{}, r<100, 127>{}, c<-128>{}, r<-100, -20>{});
+    check_kernel(random_values<std::uint8_t>(1001), c<0>{}, r<'a', 'z'>{}, r<'0', '9'>{}, c<' '>{}, r<200, 255>{});
+    check_kernel(random_values<std::int16_t>(999), r<-1000, 1000>{}, c<-1>{}, r<-32768, -30000>{}, r<30000, 40000>{});
+    check_kernel(random_values<std::uint16_t>(999), r<0, 1000>{}, c<65535>{}, r<40000, 50000>{});
+    check_kernel(random_values<std::int32_t>(777), r<0, 1 << 30>{}, c<-1>{}, r<std::numeric_limits<std::int32_t>::min(), -(1 << 30)>{}, c<7>{});
+    check_kernel(random_values<std::uint32_t>(777), r<0, 1u << 30>{}, c<-1>{}, r<3u << 30, 0xffffffffu>{}, c<7>{});
+}
+
+void test_avx2_64_bit_lanes()
+{
+    check_kernel(random_values<std::int64_t>(555), r<0LL, (1LL << 62)>{}, c<-1>{}, r<std::numeric_limits<std::int64_t>::min(), -(1LL << 62)>{}, c<42>{});
+    check_kernel(random_values<std::uint64_t>(555), r<0ULL, (1ULL << 63)>{}, c<~0ULL>{}, r<(3ULL << 62), ~0ULL - 1>{});
+
+    // Values at the edges of the intervals, where the sign-flipped comparison of 64-bit lanes is easiest to get wrong
+    std::vector<std::int64_t> _edges{0, 1, -1, 41, 42, 43, (1LL << 62) - 1, 1LL << 62, (1LL << 62) + 1, -(1LL << 62) - 1, -(1LL << 62),
+                                     std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()};
+    check_kernel(_edges, c<42>{}, r<0LL, (1LL << 62)>{}, r<std::numeric_limits<std::int64_t>::min(), -(1LL << 62)>{}, c<-1>{});
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_avx2_kernels), cxx_tests::make_test(test_avx2_64_bit_lanes));
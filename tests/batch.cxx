@@ -0,0 +1,126 @@
+#include <batch.hxx>
+
+#include "test-helper.hxx"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+template <auto V>
+using c = cxx_patterns::constant<V>;
+
+template <auto Lo, auto Hi>
+using r = cxx_patterns::inclusive_range<Lo, Hi>;
+
+template <typename T>
+std::vector<T> random_values(std::size_t _n)
+{
+    std::mt19937_64 _rng{_n};
+    std::vector<T> _vals(_n);
+    for (T &_val : _vals)
+        _val = static_cast<T>(_rng());
+    return _vals;
+}
+
+template <typename T, typename... Pats>
+void check_classify(const std::vector<T> &_vals, const Pats &..._pats)
+{
+    std::vector<std::uint16_t> _indices(_vals.size());
+    cxx_patterns::classify(_vals, _indices, _pats...);
+
+    for (std::size_t _i = 0; _i < _vals.size(); _i++)
+    {
+        std::uint16_t _expected{0};
+        static_cast<void>(((cxx_patterns::match_pattern(_pats, _vals[_i]) ? true : (++_expected, false)) || ...));
+        cxx_tests::test_assert(_indices[_i] == _expected, "element {} ({}) classified as {}, expected {}"sv, _i, static_cast<long long>(_vals[_i]), _indices[_i], _expected);
+    }
+}
+
+void test_classify_intervals()
+{
+    // Lengths that are not a multiple of any vector width exercise the scalar tail
+    check_classify(random_values<std::int8_t>(1001), c<0>{}, r<-5, 5>{}, r<100, 127>{}, c<-128>{}, r<-100, -20>{});
+    check_classify(random_values<std::uint8_t>(1001), c<0>{}, r<'a', 'z'>{}, r<'0', '9'>{}, c<' '>{}, r<200, 255>{});
+    check_classify(random_values<std::int16_t>(999), r<-1000, 1000>{}, c<-1>{}, r<-32768, -30000>{}, r<30000, 40000>{});
+    check_classify(random_values<std::uint32_t>(777), r<0, 1u << 30>{}, c<-1>{}, r<3u << 30, 0xffffffffu>{}, c<7>{});
+    check_classify(random_values<std::int64_t>(555), r<0LL, (1LL << 62)>{}, c<-1>{}, r<std::numeric_limits<std::int64_t>::min(), -(1LL << 62)>{}, c<42>{});
+
+    std::vector<int> _small{-3, -1, 0, 1, 2, 9, 10, 11, 50, 99, 100, 101, 7, 8, 6, 5, 4, 3};
+    check_classify(_small, c<0>{}, r<1, 9>{}, c<10>{}, r<5, 100>{}, r<-2, -1>{});
+}
+
+void test_classify_general_patterns()
+{
+    std::vector<int> _vals{1, 2, 3, 4, 5, 6};
+    check_classify(_vals, 3, 5, cxx_patterns::binding{});
+}
+
+void test_count_matches()
+{
+    std::vector<unsigned char> _bytes{'a', 'b', '1', ' ', 'Z', 'z', '9', '\n', 'q'};
+    auto _counts = cxx_patterns::count_matches(_bytes, r<'a', 'z'>{}, r<'0', '9'>{}, c<' '>{}, c<'\n'>{});
+
+    cxx_tests::test_assert(_counts[0] == 4 && _counts[1] == 2 && _counts[2] == 1 && _counts[3] == 1 && _counts[4] == 1, "counts {} {} {} {} {}"sv,
+                           _counts[0], _counts[1], _counts[2], _counts[3], _counts[4]);
+
+    auto _many = cxx_patterns::count_matches(random_values<std::int32_t>(10000), r<0, std::numeric_limits<std::int32_t>::max()>{}, c<0>{});
+    cxx_tests::test_assert(_many[0] + _many[2] == 10000 && _many[1] == 0, "counts {} {} {}"sv, _many[0], _many[1], _many[2]);
+}
+
+void test_partition_matches()
+{
+    std::vector<int> _vals{5, -1, 12, 3, 0, 20, -7, 8, 1};
+    std::vector<int> _out(_vals.size());
+
+    auto _offsets = cxx_patterns::partition_matches(_vals, _out, r<0, 9>{}, r<10, 19>{}, c<20>{}, c<21>{});
+
+    constexpr std::array<std::size_t, 6> _expected_offsets{0, 5, 6, 7, 7, 9};
+    cxx_tests::test_assert(_offsets == _expected_offsets, "unexpected offsets"sv);
+
+    const std::vector<int> _expected{5, 3, 0, 8, 1, 12, 20, -1, -7};
+    cxx_tests::test_assert(_out == _expected, "unexpected partition"sv);
+}
+
+void test_match_many()
+{
+    std::vector<std::int16_t> _vals{random_values<std::int16_t>(1000)};
+    std::array<std::size_t, 4> _hits{};
+
+    cxx_patterns::match_many(_vals,
+                             cxx_patterns::match_arm{c<0>{}, [&]
+                                                     { _hits[0]++; }},
+                             cxx_patterns::match_arm{r<1, 1000>{}, [&]
+                                                     { _hits[1]++; return 1; }},
+                             cxx_patterns::match_arm{r<-1000, 500>{}, [&]
+                                                     { _hits[2]++; }},
+                             cxx_patterns::match_arm{r<-32768, -1001>{}, [&]
+                                                     { _hits[3]++; }});
+
+    auto _counts = cxx_patterns::count_matches(_vals, c<0>{}, r<1, 1000>{}, r<-1000, 500>{}, r<-32768, -1001>{});
+    for (std::size_t _i = 0; _i < _hits.size(); _i++)
+        cxx_tests::test_assert(_hits[_i] == _counts[_i], "arm {} invoked {} times, expected {}"sv, _i, _hits[_i], _counts[_i]);
+
+    std::vector<int> _ints{1, 2, 3, 4};
+    int _sum{};
+    cxx_patterns::match_many(_ints,
+                             cxx_patterns::match_arm{2, []() {}},
+                             cxx_patterns::match_arm{cxx_patterns::binding{}, [&](int &_x)
+                                                     { _sum += _x; _x = 0; }});
+    cxx_tests::test_assert(_sum == 8, "sum {}"sv, _sum);
+    cxx_tests::test_assert(_ints == std::vector<int>{0, 2, 0, 0}, "elements bound by reference"sv);
+
+    // Arms that bind nothing are invoked from the classified index even when their patterns are not intervals
+    std::array<std::size_t, 2> _seen{};
+    cxx_patterns::match_many(std::vector<int>{1, 3, 5, 3, 6}, cxx_patterns::match_arm{3, [&]
+                                                                                   { _seen[0]++; }},
+                             cxx_patterns::match_arm{5, [&]
+                                                     { _seen[1]++; }});
+    cxx_tests::test_assert(_seen[0] == 2 && _seen[1] == 1, "arms invoked {} and {} times"sv, _seen[0], _seen[1]);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_classify_intervals), cxx_tests::make_test(test_classify_general_patterns), cxx_tests::make_test(test_count_matches),
+            cxx_tests::make_test(test_partition_matches), cxx_tests::make_test(test_match_many));
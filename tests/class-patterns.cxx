@@ -0,0 +1,265 @@
+#include <match.hxx>
+#include <class-patterns.hxx>
+
+#include "test-helper.hxx"
+
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+using namespace std::string_view_literals;
+
+// An LLVM-style hierarchy: each class covers a contiguous range of kinds, and an abstract class covers the kinds of its subclasses
+enum class expr_kind
+{
+    literal,
+    first_binary,
+    add = first_binary,
+    mul,
+    last_binary = mul,
+    call,
+};
+
+int kind_reads{};
+
+struct expr
+{
+    const expr_kind _m_kind;
+
+    explicit constexpr expr(expr_kind _kind) noexcept : _m_kind{_kind} {}
+
+    expr_kind kind() const noexcept
+    {
+        kind_reads++;
+        return this->_m_kind;
+    }
+};
+
+struct literal : expr
+{
+    static constexpr expr_kind first_kind{expr_kind::literal}, last_kind{expr_kind::literal};
+
+    int _m_value;
+
+    explicit constexpr literal(int _value) noexcept : expr{expr_kind::literal}, _m_value{_value} {}
+};
+
+struct binary : expr
+{
+    static constexpr expr_kind first_kind{expr_kind::first_binary}, last_kind{expr_kind::last_binary};
+
+    const expr &_m_lhs;
+    const expr &_m_rhs;
+
+    constexpr binary(expr_kind _kind, const expr &_lhs, const expr &_rhs) noexcept : expr{_kind}, _m_lhs{_lhs}, _m_rhs{_rhs} {}
+};
+
+struct add : binary
+{
+    static constexpr expr_kind first_kind{expr_kind::add}, last_kind{expr_kind::add};
+
+    constexpr add(const expr &_lhs, const expr &_rhs) noexcept : binary{expr_kind::add, _lhs, _rhs} {}
+};
+
+struct mul : binary
+{
+    static constexpr expr_kind first_kind{expr_kind::mul}, last_kind{expr_kind::mul};
+
+    constexpr mul(const expr &_lhs, const expr &_rhs) noexcept : binary{expr_kind::mul, _lhs, _rhs} {}
+};
+
+struct call : expr
+{
+    static constexpr expr_kind first_kind{expr_kind::call}, last_kind{expr_kind::call};
+
+    constexpr call() noexcept : expr{expr_kind::call} {}
+};
+
+static_assert(cxx_patterns::kind_tagged<expr> && std::same_as<cxx_patterns::class_kind_t<expr>, expr_kind>);
+static_assert(cxx_patterns::identifiable_subclass<add, expr> && cxx_patterns::identifiable_subclass<binary, expr> && cxx_patterns::identifiable_subclass<expr, add>);
+static_assert(!cxx_patterns::identifiable_subclass<add, int>);
+
+// A hierarchy without a kind tag, recognized by `classof`
+struct message
+{
+    int _m_type;
+};
+
+struct ping : message
+{
+    static constexpr bool classof(const message *_msg) noexcept
+    {
+        return _msg->_m_type == 1;
+    }
+};
+
+void test_instance_of()
+{
+    const literal _one{1};
+    const literal _two{2};
+    const add _sum{_one, _two};
+    const expr &_expr{_sum};
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::instance_of<add>{}, _expr);
+    cxx_tests::test_assert_expr(_bind);
+    static_assert(std::same_as<decltype(std::get<0>(*_bind)), const add &>);
+    cxx_tests::test_assert_expr(&std::get<0>(*_bind) == &_sum);
+
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::instance_of<binary>{}, _expr));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::instance_of<mul>{}, _expr));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::instance_of<literal>{}, _expr));
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::instance_of<expr>{}, _expr));
+
+    auto _nested = cxx_patterns::match_pattern(cxx_patterns::instance_of<literal, cxx_patterns::binding<>>{}, static_cast<const expr &>(_two));
+    cxx_tests::test_assert_expr(_nested && std::get<0>(*_nested)._m_value == 2);
+}
+
+void test_instance_of_pointer()
+{
+    literal _lit{7};
+    expr *_ptr{&_lit};
+    expr *_null{nullptr};
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::instance_of<literal>{}, _ptr);
+    cxx_tests::test_assert_expr(_bind);
+    static_assert(std::same_as<decltype(std::get<0>(*_bind)), literal &>);
+    std::get<0>(*_bind)._m_value = 8;
+    cxx_tests::test_assert_expr(_lit._m_value == 8);
+
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::instance_of<literal>{}, _null));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::instance_of<expr>{}, _null));
+}
+
+void test_classof()
+{
+    const ping _ping{{1}};
+    const message _other{2};
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::instance_of<ping>{}, static_cast<const message &>(_ping));
+    cxx_tests::test_assert_expr(_bind && &std::get<0>(*_bind) == &_ping);
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::instance_of<ping>{}, _other));
+}
+
+int evaluate(const expr &_expr)
+{
+    return cxx_patterns::match(_expr,
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<literal>{}, [](const literal &_lit)
+                                                       { return _lit._m_value; }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<add>{}, [](const add &_add)
+                                                       { return evaluate(_add._m_lhs) + evaluate(_add._m_rhs); }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<mul>{}, [](const mul &_mul)
+                                                       { return evaluate(_mul._m_lhs) * evaluate(_mul._m_rhs); }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](const expr &)
+                                                       { return -1; }});
+}
+
+void test_match_kind_dispatch()
+{
+    const literal _two{2};
+    const literal _three{3};
+    const literal _four{4};
+    const add _sum{_two, _three};
+    const mul _product{_sum, _four};
+    const call _call{};
+
+    cxx_tests::test_assert(evaluate(_product) == 20, "(2 + 3) * 4 == {}"sv, evaluate(_product));
+    cxx_tests::test_assert_expr(evaluate(_call) == -1);
+
+    // The kind is read once to find the arm, however many arms precede it
+    kind_reads = 0;
+    evaluate(_four);
+    const int _first{kind_reads};
+    kind_reads = 0;
+    evaluate(_call);
+    cxx_tests::test_assert(_first == 1 && kind_reads == 1, "kind read {} and {} times"sv, _first, kind_reads);
+}
+
+// The kind table binds the downcast reference with the value category of the scrutinee, as each `instance_of` pattern does on its own
+int consume(expr &&_expr)
+{
+    return cxx_patterns::match(std::move(_expr),
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<literal, cxx_patterns::binding<>>{}, [](literal &&_lit)
+                                                       { return _lit._m_value; }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<add>{}, [](add &&)
+                                                       { return 2; }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<mul>{}, [](mul &&)
+                                                       { return 3; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](expr &&)
+                                                       { return -1; }});
+}
+
+void test_match_kind_rvalue()
+{
+    const literal _one{1};
+
+    cxx_tests::test_assert_expr(consume(literal{7}) == 7);
+    cxx_tests::test_assert_expr(consume(add{_one, _one}) == 2);
+    cxx_tests::test_assert_expr(consume(mul{_one, _one}) == 3);
+    cxx_tests::test_assert_expr(consume(call{}) == -1);
+}
+
+// Matches a literal with a positive value
+struct positive
+{
+    constexpr std::optional<std::tuple<>> match(const literal &_lit) const noexcept
+    {
+        if (_lit._m_value > 0)
+            return std::tuple<>{};
+        else
+            return std::nullopt;
+    }
+};
+
+int sign(const expr &_expr)
+{
+    return cxx_patterns::match(_expr,
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<literal, positive>{}, []()
+                                                       { return 1; }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<literal>{}, [](const literal &_lit)
+                                                       { return _lit._m_value < 0 ? -1 : 0; }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<binary>{}, [](const binary &)
+                                                       { return 2; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](const expr &)
+                                                       { return 3; }});
+}
+
+void test_match_kind_nested()
+{
+    const literal _pos{5};
+    const literal _neg{-5};
+    const add _sum{_pos, _neg};
+
+    cxx_tests::test_assert_expr(sign(_pos) == 1);
+    cxx_tests::test_assert_expr(sign(_neg) == -1);
+    cxx_tests::test_assert_expr(sign(_sum) == 2);
+    cxx_tests::test_assert_expr(sign(call{}) == 3);
+}
+
+const char *describe(const expr *_expr)
+{
+    return cxx_patterns::match(_expr,
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<add>{}, [](const add &)
+                                                       { return "add"; }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<binary>{}, [](const binary &)
+                                                       { return "binary"; }},
+                               cxx_patterns::match_arm{cxx_patterns::instance_of<expr>{}, [](const expr &)
+                                                       { return "expr"; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](const expr *)
+                                                       { return "null"; }});
+}
+
+void test_match_kind_ranges()
+{
+    const literal _one{1};
+    const add _sum{_one, _one};
+    const mul _product{_one, _one};
+
+    cxx_tests::test_assert_expr(describe(&_sum) == "add"sv);
+    cxx_tests::test_assert_expr(describe(&_product) == "binary"sv);
+    cxx_tests::test_assert_expr(describe(&_one) == "expr"sv);
+    cxx_tests::test_assert_expr(describe(nullptr) == "null"sv);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_instance_of), cxx_tests::make_test(test_instance_of_pointer), cxx_tests::make_test(test_classof),
+            cxx_tests::make_test(test_match_kind_dispatch), cxx_tests::make_test(test_match_kind_rvalue), cxx_tests::make_test(test_match_kind_nested), cxx_tests::make_test(test_match_kind_ranges));
@@ -0,0 +1,101 @@
+#include <match.hxx>
+#include <integral-patterns.hxx>
+
+#include "test-helper.hxx"
+
+using namespace std::string_view_literals;
+
+void test_constant_pattern()
+{
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::constant<5>{}, 5));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::constant<5>{}, 6));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::constant<-1>{}, static_cast<unsigned>(-1)));
+}
+
+void test_inclusive_range_pattern()
+{
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::inclusive_range<'a', 'z'>{}, 'q'));
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::inclusive_range<-3, 3>{}, -3));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::inclusive_range<-3, 3>{}, 4));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::inclusive_range<3, -3>{}, 0));
+}
+
+int classify_dense(int _op)
+{
+    return cxx_patterns::match(_op,
+                               cxx_patterns::match_arm{cxx_patterns::constant<0>{}, []()
+                                                       { return 10; }},
+                               cxx_patterns::match_arm{cxx_patterns::constant<1>{}, []()
+                                                       { return 11; }},
+                               cxx_patterns::match_arm{cxx_patterns::inclusive_range<2, 7>{}, []()
+                                                       { return 12; }},
+                               cxx_patterns::match_arm{cxx_patterns::inclusive_range<5, 9>{}, []()
+                                                       { return 13; }},
+                               cxx_patterns::match_arm{cxx_patterns::constant<-4>{}, []()
+                                                       { return 14; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](int)
+                                                       { return -1; }});
+}
+
+void test_match_dense_table()
+{
+    cxx_tests::test_assert(classify_dense(0) == 10, "match 0"sv);
+    cxx_tests::test_assert(classify_dense(1) == 11, "match 1"sv);
+    cxx_tests::test_assert(classify_dense(2) == 12, "match 2"sv);
+    cxx_tests::test_assert(classify_dense(6) == 12, "match 6 (first overlapping arm wins)"sv);
+    cxx_tests::test_assert(classify_dense(8) == 13, "match 8"sv);
+    cxx_tests::test_assert(classify_dense(-4) == 14, "match -4"sv);
+    cxx_tests::test_assert(classify_dense(-3) == -1, "match -3 (gap in table)"sv);
+    cxx_tests::test_assert(classify_dense(10) == -1, "match 10"sv);
+    cxx_tests::test_assert(classify_dense(std::numeric_limits<int>::min()) == -1, "match INT_MIN"sv);
+}
+
+int classify_sparse(unsigned long long _code)
+{
+    return cxx_patterns::match(_code,
+                               cxx_patterns::match_arm{cxx_patterns::constant<100>{}, []()
+                                                       { return 0; }},
+                               cxx_patterns::match_arm{cxx_patterns::constant<100000>{}, []()
+                                                       { return 1; }},
+                               cxx_patterns::match_arm{cxx_patterns::inclusive_range<1'000'000'000, 2'000'000'000>{}, []()
+                                                       { return 2; }},
+                               cxx_patterns::match_arm{cxx_patterns::constant<~0ULL>{}, []()
+                                                       { return 3; }},
+                               cxx_patterns::match_arm{cxx_patterns::constant<-1>{}, []()
+                                                       { return 4; }},
+                               cxx_patterns::match_arm{5ULL, []()
+                                                       { return 5; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](unsigned long long)
+                                                       { return -1; }});
+}
+
+void test_match_sparse_table()
+{
+    cxx_tests::test_assert(classify_sparse(100) == 0, "match 100"sv);
+    cxx_tests::test_assert(classify_sparse(100000) == 1, "match 100000"sv);
+    cxx_tests::test_assert(classify_sparse(1'500'000'000) == 2, "match 1500000000"sv);
+    cxx_tests::test_assert(classify_sparse(~0ULL) == 3, "match ~0"sv);
+    cxx_tests::test_assert(classify_sparse(5) == 5, "match 5 (after the table)"sv);
+    cxx_tests::test_assert(classify_sparse(101) == -1, "match 101"sv);
+    cxx_tests::test_assert(classify_sparse(0) == -1, "match 0"sv);
+}
+
+void test_match_table_void()
+{
+    int _hits{};
+    for (char _c : "az09_"sv)
+        cxx_patterns::match(_c,
+                            cxx_patterns::match_arm{cxx_patterns::inclusive_range<'a', 'z'>{}, [&]()
+                                                    { _hits += 1; }},
+                            cxx_patterns::match_arm{cxx_patterns::inclusive_range<'A', 'Z'>{}, []()
+                                                    { cxx_tests::test_assert(false, "upper"sv); }},
+                            cxx_patterns::match_arm{cxx_patterns::inclusive_range<'0', '9'>{}, [&]()
+                                                    { _hits += 10; }},
+                            cxx_patterns::match_arm{cxx_patterns::constant<'_'>{}, [&]()
+                                                    { _hits += 100; }});
+
+    cxx_tests::test_assert(_hits == 122, "hits {}"sv, _hits);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_constant_pattern), cxx_tests::make_test(test_inclusive_range_pattern), cxx_tests::make_test(test_match_dense_table),
+            cxx_tests::make_test(test_match_sparse_table), cxx_tests::make_test(test_match_table_void));
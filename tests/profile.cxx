@@ -0,0 +1,192 @@
+#define CXX_PATTERNS_PROFILE
+
+#include <match.hxx>
+#include <profile.hxx>
+
+#include "test-helper.hxx"
+
+#include <algorithm>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+using namespace std::string_view_literals;
+
+std::optional<cxx_patterns::site_profile> find_site(std::string_view _site)
+{
+    for (auto &_profile : cxx_patterns::profile_snapshot())
+        if (_profile.site == _site)
+            return std::move(_profile);
+    return std::nullopt;
+}
+
+int classify(int _val)
+{
+    return cxx_patterns::match<cxx_patterns::profile<"classify">>(_val,
+                                                                  cxx_patterns::match_arm{cxx_patterns::constant<0>{}, []()
+                                                                                          { return 0; }},
+                                                                  cxx_patterns::match_arm{cxx_patterns::inclusive_range<1, 9>{}, []()
+                                                                                          { return 1; }},
+                                                                  cxx_patterns::match_arm{cxx_patterns::binding{}, [](int)
+                                                                                          { return 2; }});
+}
+
+void test_profile_counts()
+{
+    for (int _val : {0, 5, 5, 7, 42})
+        classify(_val);
+
+    auto _profile{find_site("classify"sv)};
+    cxx_tests::test_assert_expr(_profile && _profile->arms.size() == 3);
+    cxx_tests::test_assert(_profile->arms[0].hits == 1 && _profile->arms[0].mismatches == 4, "arm 0: {} hits, {} mismatches"sv, _profile->arms[0].hits, _profile->arms[0].mismatches);
+    cxx_tests::test_assert(_profile->arms[1].hits == 3 && _profile->arms[1].mismatches == 1, "arm 1: {} hits, {} mismatches"sv, _profile->arms[1].hits, _profile->arms[1].mismatches);
+    cxx_tests::test_assert(_profile->arms[2].hits == 1 && _profile->arms[2].mismatches == 0, "arm 2: {} hits, {} mismatches"sv, _profile->arms[2].hits, _profile->arms[2].mismatches);
+}
+
+void count_word(std::string_view _word)
+{
+    cxx_patterns::match<cxx_patterns::profile<"count_word">>(_word,
+                                                             cxx_patterns::match_arm{cxx_patterns::string_constant<"yes">{}, []() {}},
+                                                             cxx_patterns::match_arm{cxx_patterns::binding{}, [](std::string_view) {}});
+}
+
+void test_profile_threads()
+{
+    std::thread _worker{[]
+                        {
+                            for (int _i = 0; _i < 100; _i++)
+                                count_word("yes"sv);
+                        }};
+    _worker.join();
+    count_word("no"sv);
+
+    auto _profile{find_site("count_word"sv)};
+    cxx_tests::test_assert_expr(_profile);
+    cxx_tests::test_assert(_profile->arms[0].hits == 100, "counts of an exited thread are kept: {}"sv, _profile->arms[0].hits);
+    cxx_tests::test_assert_expr(_profile->arms[0].mismatches == 1 && _profile->arms[1].hits == 1);
+}
+
+void test_dump_profile()
+{
+    for (int _val : {3, 4, 0})
+        classify(_val);
+
+    std::ostringstream _out;
+    cxx_patterns::dump_profile(_out);
+    const std::string _dump{_out.str()};
+    cxx_tests::test_assert(_dump.contains("classify (3 arms)\n"), "site header in {}"sv, _dump);
+    cxx_tests::test_assert(_dump.contains("cxx_patterns::prioritize<1, 0, 2>\n"), "suggested policy in {}"sv, _dump);
+}
+
+struct shape
+{
+    int _m_kind;
+
+    int kind() const noexcept
+    {
+        return this->_m_kind;
+    }
+};
+
+struct circle : shape
+{
+    static constexpr int first_kind{0}, last_kind{0};
+};
+
+struct polygon : shape
+{
+    static constexpr int first_kind{1}, last_kind{9};
+};
+
+struct square : polygon
+{
+    static constexpr int first_kind{4}, last_kind{4};
+};
+
+template <typename Plan, std::size_t... Order>
+constexpr bool has_order(std::index_sequence<Order...>) noexcept
+{
+    return std::ranges::equal(Plan::_s_plan.order, std::array{Order...});
+}
+
+void test_priority_plan()
+{
+    using _distinct = cxx_patterns::_detail::_priority_plan<int, std::index_sequence<2, 1>, cxx_patterns::constant<1>, cxx_patterns::constant<2>, cxx_patterns::inclusive_range<5, 9>, cxx_patterns::binding<>>;
+    static_assert(has_order<_distinct>(std::index_sequence<2, 1, 0, 3>{}));
+    static_assert(std::same_as<_distinct::likely, std::index_sequence<0, 1>>);
+
+    // The range overlaps the constant before it, so it cannot be moved, but the arms after it can move ahead of it
+    using _overlap = cxx_patterns::_detail::_priority_plan<int, std::index_sequence<1, 2>, cxx_patterns::constant<5>, cxx_patterns::inclusive_range<0, 9>, cxx_patterns::constant<12>>;
+    static_assert(has_order<_overlap>(std::index_sequence<2, 0, 1>{}));
+    static_assert(std::same_as<_overlap::likely, std::index_sequence<0, 2>>);
+
+    // A catch-all is never moved ahead of anything
+    using _catch_all = cxx_patterns::_detail::_priority_plan<int, std::index_sequence<1>, cxx_patterns::constant<5>, cxx_patterns::binding<>>;
+    static_assert(has_order<_catch_all>(std::index_sequence<0, 1>{}));
+
+    // Out-of-range values of the scrutinee type cannot overlap
+    using _clamped = cxx_patterns::_detail::_priority_plan<unsigned char, std::index_sequence<1>, cxx_patterns::inclusive_range<-5, 0>, cxx_patterns::inclusive_range<1, 300>>;
+    static_assert(has_order<_clamped>(std::index_sequence<1, 0>{}));
+
+    using _strings = cxx_patterns::_detail::_priority_plan<std::string_view, std::index_sequence<1>, cxx_patterns::string_constant<"a">, cxx_patterns::string_constant<"b">>;
+    static_assert(has_order<_strings>(std::index_sequence<1, 0>{}));
+
+    // A `square` is a `polygon`, so it cannot move ahead of it, but a `polygon` is never a `circle`
+    using _classes = cxx_patterns::_detail::_priority_plan<const shape &, std::index_sequence<2, 1>, cxx_patterns::instance_of<circle>, cxx_patterns::instance_of<polygon>, cxx_patterns::instance_of<square>>;
+    static_assert(has_order<_classes>(std::index_sequence<1, 0, 2>{}));
+}
+
+int prioritized(int _val)
+{
+    return cxx_patterns::match<cxx_patterns::prioritize<3, 1>>(_val,
+                                                               cxx_patterns::match_arm{cxx_patterns::constant<1>{}, []()
+                                                                                       { return 10; }},
+                                                               cxx_patterns::match_arm{cxx_patterns::inclusive_range<0, 9>{}, []()
+                                                                                       { return 11; }},
+                                                               cxx_patterns::match_arm{20, []()
+                                                                                       { return 12; }},
+                                                               cxx_patterns::match_arm{cxx_patterns::constant<30>{}, []()
+                                                                                       { return 13; }},
+                                                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](int _v)
+                                                                                       { return _v; }});
+}
+
+void test_prioritize()
+{
+    for (int _val : {1, 0, 9, 20, 30, 31, -4})
+    {
+        const int _expected{_val == 1 ? 10 : (_val >= 0 && _val <= 9) ? 11
+                                         : _val == 20                 ? 12
+                                         : _val == 30                 ? 13
+                                                                      : _val};
+        cxx_tests::test_assert(prioritized(_val) == _expected, "prioritized({}) == {}"sv, _val, prioritized(_val));
+    }
+
+    std::string_view _seen;
+    cxx_patterns::match<cxx_patterns::prioritize<1>>("b"sv,
+                                                     cxx_patterns::match_arm{cxx_patterns::string_constant<"a">{}, [&]()
+                                                                             { _seen = "a"sv; }},
+                                                     cxx_patterns::match_arm{cxx_patterns::string_constant<"b">{}, [&]()
+                                                                             { _seen = "b"sv; }},
+                                                     cxx_patterns::match_arm{cxx_patterns::binding{}, [&](std::string_view)
+                                                                             { _seen = "other"sv; }});
+    cxx_tests::test_assert_expr(_seen == "b"sv);
+}
+
+void test_default_policy()
+{
+    static_assert(cxx_patterns::match_policy<cxx_patterns::default_match_policy, int, cxx_patterns::match_arm<cxx_patterns::binding<>, int (*)(int)>>);
+    static_assert(!cxx_patterns::match_policy<int, int, cxx_patterns::match_arm<cxx_patterns::binding<>, int (*)(int)>>);
+
+    const int _res = cxx_patterns::match<cxx_patterns::default_match_policy>(4,
+                                                                            cxx_patterns::match_arm{cxx_patterns::constant<4>{}, []()
+                                                                                                    { return 1; }},
+                                                                            cxx_patterns::match_arm{cxx_patterns::binding{}, [](int)
+                                                                                                    { return 0; }});
+    cxx_tests::test_assert_expr(_res == 1);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_profile_counts), cxx_tests::make_test(test_profile_threads), cxx_tests::make_test(test_dump_profile),
+            cxx_tests::make_test(test_priority_plan), cxx_tests::make_test(test_prioritize), cxx_tests::make_test(test_default_policy));
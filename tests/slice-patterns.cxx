@@ -0,0 +1,102 @@
+#include <match.hxx>
+#include <slice-patterns.hxx>
+
+#include "test-helper.hxx"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+template <typename... Bytes>
+constexpr std::array<std::byte, sizeof...(Bytes)> bytes(Bytes... _bytes) noexcept
+{
+    return {static_cast<std::byte>(_bytes)...};
+}
+
+void test_slice_fields()
+{
+    constexpr auto _buf{bytes('P', 'K', 0x12, 0x34, 0x78, 0x56, 0x34, 0x12, 9, 8, 7)};
+    std::span<const std::byte> _view{_buf};
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::magic<"PK">{}, cxx_patterns::field<std::uint16_t, std::endian::big>{},
+                                                                 cxx_patterns::field<std::uint32_t, std::endian::little>{}, cxx_patterns::rest{}},
+                                             _view);
+    cxx_tests::test_assert_expr(_bind);
+
+    auto &&[_version, _length, _payload] = *_bind;
+    cxx_tests::test_assert(_version == 0x1234, "big endian field {}"sv, _version);
+    cxx_tests::test_assert(_length == 0x12345678, "little endian field {}"sv, _length);
+    cxx_tests::test_assert(_payload.data() == _buf.data() + 8 && _payload.size() == 3, "rest refers to the buffer"sv);
+
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::magic<"PZ">{}, cxx_patterns::rest{}}, _view));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::magic<"PK">{}, cxx_patterns::field<std::uint16_t, std::endian::big, cxx_patterns::constant<0x1235>>{}, cxx_patterns::rest{}}, _view));
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::magic<"PK">{}, cxx_patterns::field<std::uint16_t, std::endian::big, cxx_patterns::constant<0x1234>>{}, cxx_patterns::rest{}}, _view));
+}
+
+void test_slice_length()
+{
+    constexpr auto _buf{bytes(1, 2, 3)};
+    std::span<const std::byte> _view{_buf};
+
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::skip<3>{}}, _view));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::skip<2>{}}, _view));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::skip<4>{}, cxx_patterns::ignore_rest{}}, _view));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::field<std::uint32_t>{}}, _view.first(2)));
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::skip<3>{}, cxx_patterns::rest{}}, _view);
+    cxx_tests::test_assert_expr(_bind && std::get<0>(*_bind).empty());
+}
+
+void test_slice_elements()
+{
+    std::vector<int> _vals{4, 5, 6, 7};
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::element<cxx_patterns::constant<4>>{}, cxx_patterns::element{}, cxx_patterns::rest{}}, _vals);
+    cxx_tests::test_assert_expr(_bind);
+
+    auto &&[_second, _tail] = *_bind;
+    cxx_tests::test_assert_expr(&_second == &_vals[1]);
+    cxx_tests::test_assert_expr(_tail.data() == &_vals[2] && _tail.size() == 2);
+
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::element<int>{5}, cxx_patterns::rest{}}, _vals));
+}
+
+void test_slice_constexpr()
+{
+    constexpr auto _buf{bytes(0x7f, 'E', 'L', 'F', 2, 1)};
+    constexpr auto _bind = cxx_patterns::match_pattern(cxx_patterns::slice{cxx_patterns::magic<"\x7f"
+                                                                                               "ELF">{},
+                                                                           cxx_patterns::field<std::uint16_t, std::endian::big>{}},
+                                                       std::span<const std::byte>{_buf});
+    static_assert(_bind && std::get<0>(*_bind) == 0x0201);
+}
+
+int packet_kind(std::span<const std::byte> _packet)
+{
+    return cxx_patterns::match(_packet,
+                               cxx_patterns::match_arm{cxx_patterns::slice{cxx_patterns::magic<"HI">{}, cxx_patterns::ignore_rest{}}, []()
+                                                       { return 0; }},
+                               cxx_patterns::match_arm{cxx_patterns::slice{cxx_patterns::magic<"DT">{}, cxx_patterns::field<std::uint16_t, std::endian::big>{}, cxx_patterns::rest{}},
+                                                       [](std::uint16_t _len, std::span<const std::byte> _body)
+                                                       { return _len == _body.size() ? 1 : -2; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](std::span<const std::byte>)
+                                                       { return -1; }});
+}
+
+void test_match_slice()
+{
+    constexpr auto _hello{bytes('H', 'I', 1)};
+    constexpr auto _data{bytes('D', 'T', 0, 2, 'a', 'b')};
+    constexpr auto _short{bytes('D', 'T', 0)};
+
+    cxx_tests::test_assert(packet_kind(_hello) == 0, "hello"sv);
+    cxx_tests::test_assert(packet_kind(_data) == 1, "data"sv);
+    cxx_tests::test_assert(packet_kind(_short) == -1, "truncated"sv);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_slice_fields), cxx_tests::make_test(test_slice_length), cxx_tests::make_test(test_slice_elements),
+            cxx_tests::make_test(test_slice_constexpr), cxx_tests::make_test(test_match_slice));
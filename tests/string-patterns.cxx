@@ -0,0 +1,73 @@
+#include <match.hxx>
+#include <string-patterns.hxx>
+
+#include "test-helper.hxx"
+
+using namespace std::string_view_literals;
+
+void test_string_constant_pattern()
+{
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::string_constant<"get">{}, "get"sv));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::string_constant<"get">{}, "gets"sv));
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::string_constant<u"get">{}, u"get"sv));
+}
+
+int classify_verb(std::string_view _verb)
+{
+    return cxx_patterns::match(_verb,
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"GET">{}, []()
+                                                       { return 0; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"PUT">{}, []()
+                                                       { return 1; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"POST">{}, []()
+                                                       { return 2; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"HEAD">{}, []()
+                                                       { return 3; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"DELETE">{}, []()
+                                                       { return 4; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"GET">{}, []()
+                                                       { return 5; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"">{}, []()
+                                                       { return 6; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"xaaaay">{}, []()
+                                                       { return 7; }},
+                               cxx_patterns::match_arm{cxx_patterns::string_constant<"xaabay">{}, []()
+                                                       { return 8; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](std::string_view)
+                                                       { return -1; }});
+}
+
+void test_match_string_table()
+{
+    cxx_tests::test_assert(classify_verb("GET"sv) == 0, "match GET"sv);
+    cxx_tests::test_assert(classify_verb("PUT"sv) == 1, "match PUT"sv);
+    cxx_tests::test_assert(classify_verb("POST"sv) == 2, "match POST"sv);
+    cxx_tests::test_assert(classify_verb("HEAD"sv) == 3, "match HEAD"sv);
+    cxx_tests::test_assert(classify_verb("DELETE"sv) == 4, "match DELETE"sv);
+    cxx_tests::test_assert(classify_verb(""sv) == 6, "match empty string"sv);
+    cxx_tests::test_assert(classify_verb("xaaaay"sv) == 7, "match xaaaay"sv);
+    cxx_tests::test_assert(classify_verb("xaabay"sv) == 8, "match xaabay"sv);
+    cxx_tests::test_assert(classify_verb("OPTIONS"sv) == -1, "match OPTIONS (after the table)"sv);
+    cxx_tests::test_assert(classify_verb("GETS"sv) == -1, "match GETS"sv);
+    cxx_tests::test_assert(classify_verb("xaacay"sv) == -1, "match xaacay"sv);
+}
+
+void test_match_string_table_wide()
+{
+    int _hits{};
+    for (std::u32string_view _word : {U"alpha"sv, U"beta"sv, U"gamma"sv, U"delta"sv, U"omega"sv})
+        cxx_patterns::match(_word,
+                            cxx_patterns::match_arm{cxx_patterns::string_constant<U"alpha">{}, [&]()
+                                                    { _hits += 1; }},
+                            cxx_patterns::match_arm{cxx_patterns::string_constant<U"beta">{}, [&]()
+                                                    { _hits += 10; }},
+                            cxx_patterns::match_arm{cxx_patterns::string_constant<U"gamma">{}, [&]()
+                                                    { _hits += 100; }},
+                            cxx_patterns::match_arm{cxx_patterns::string_constant<U"delta">{}, [&]()
+                                                    { _hits += 1000; }},
+                            cxx_patterns::match_arm{cxx_patterns::binding{}, [](std::u32string_view) {}});
+
+    cxx_tests::test_assert(_hits == 1111, "hits {}"sv, _hits);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_string_constant_pattern), cxx_tests::make_test(test_match_string_table), cxx_tests::make_test(test_match_string_table_wide));
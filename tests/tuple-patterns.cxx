@@ -0,0 +1,143 @@
+#include <match.hxx>
+#include <tuple-patterns.hxx>
+
+#include "test-helper.hxx"
+
+#include <concepts>
+#include <optional>
+#include <string_view>
+#include <tuple>
+
+using namespace std::string_view_literals;
+
+static int counted_matches{};
+
+struct counted
+{
+    template <typename T>
+    constexpr std::optional<cxx_patterns::empty_matcher_t> match(const T &) const noexcept
+    {
+        counted_matches++;
+        return cxx_patterns::empty_matcher;
+    }
+};
+
+void test_tuple_pattern()
+{
+    std::tuple<int, char, long> _val{1, 'a', 3};
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::matcher<std::tuple<int, cxx_patterns::binding<void>, cxx_patterns::binding<void>>>{std::tuple{1, cxx_patterns::binding{}, cxx_patterns::binding{}}}, _val);
+    cxx_tests::test_assert_expr(_bind);
+
+    auto &&[_c, _l] = *_bind;
+    cxx_tests::test_assert_expr(&_c == &std::get<1>(_val));
+    cxx_tests::test_assert_expr(&_l == &std::get<2>(_val));
+}
+
+void test_tuple_pattern_short_circuit()
+{
+    std::tuple<int, int, int> _val{1, 2, 3};
+    counted_matches = 0;
+
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::matcher<std::tuple<int, counted, counted>>{std::tuple{5, counted{}, counted{}}}, _val));
+    cxx_tests::test_assert(counted_matches == 0, "later fields tested {} times"sv, counted_matches);
+
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::matcher<std::tuple<int, counted, counted>>{std::tuple{1, counted{}, counted{}}}, _val));
+    cxx_tests::test_assert(counted_matches == 2, "later fields tested {} times"sv, counted_matches);
+}
+
+void test_nested_tuple_pattern()
+{
+    std::tuple<int, std::tuple<int, char>> _val{1, {2, 'x'}};
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::matcher<std::tuple<int, std::tuple<int, cxx_patterns::binding<void>>>>{std::tuple{1, std::tuple{2, cxx_patterns::binding{}}}}, _val);
+    cxx_tests::test_assert_expr(_bind);
+    cxx_tests::test_assert_expr(std::get<0>(*_bind) == 'x');
+
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::matcher<std::tuple<int, std::tuple<int, cxx_patterns::binding<void>>>>{std::tuple{1, std::tuple{3, cxx_patterns::binding{}}}}, _val));
+}
+
+using record = std::tuple<int, unsigned char, int, std::string_view>;
+
+template <auto V>
+using c = cxx_patterns::constant<V>;
+using any = cxx_patterns::binding<void>;
+
+int classify(const record &_rec)
+{
+    return cxx_patterns::match(_rec,
+                               cxx_patterns::match_arm{std::tuple{c<0>{}, c<1>{}, any{}, any{}}, [](const int &_x, const std::string_view &)
+                                                       { return 100 + _x; }},
+                               cxx_patterns::match_arm{std::tuple{c<0>{}, cxx_patterns::inclusive_range<2, 9>{}, c<7>{}, any{}}, [](const std::string_view &)
+                                                       { return 1; }},
+                               cxx_patterns::match_arm{std::tuple{c<1>{}, any{}, any{}, cxx_patterns::string_constant<"x">{}}, [](const unsigned char &, const int &)
+                                                       { return 2; }},
+                               cxx_patterns::match_arm{std::tuple{c<1>{}, c<5>{}, any{}, any{}}, [](const int &, const std::string_view &)
+                                                       { return 3; }},
+                               cxx_patterns::match_arm{std::tuple{any{}, any{}, cxx_patterns::inclusive_range<-10, -1>{}, any{}}, [](const int &, const unsigned char &, const std::string_view &)
+                                                       { return 4; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](const record &)
+                                                       { return -1; }});
+}
+
+void test_match_tuple_tree()
+{
+    cxx_tests::test_assert(classify(record{0, 1, 42, "a"sv}) == 142, "arm 0"sv);
+    cxx_tests::test_assert(classify(record{0, 3, 7, "a"sv}) == 1, "arm 1"sv);
+    cxx_tests::test_assert(classify(record{0, 3, 8, "a"sv}) == -1, "no arm"sv);
+    cxx_tests::test_assert(classify(record{1, 5, 0, "x"sv}) == 2, "arm 2 before arm 3"sv);
+    cxx_tests::test_assert(classify(record{1, 5, 0, "y"sv}) == 3, "arm 3 after opaque arm 2 fails"sv);
+    cxx_tests::test_assert(classify(record{2, 5, -3, "y"sv}) == 4, "arm 4"sv);
+    cxx_tests::test_assert(classify(record{0, 1, -3, "y"sv}) == 97, "arm 0 before arm 4"sv);
+}
+
+static int interval_matches{};
+
+// An interval pattern that counts how many times it is tested
+template <int Lo, int Hi>
+struct counted_range
+{
+    static constexpr int lower{Lo};
+    static constexpr int upper{Hi};
+
+    template <std::integral I>
+    constexpr std::optional<cxx_patterns::empty_matcher_t> match(const I &_val) const noexcept
+    {
+        interval_matches++;
+        return cxx_patterns::inclusive_range<Lo, Hi>{}.match(_val);
+    }
+};
+
+int classify_counted(const std::tuple<int, int> &_val)
+{
+    return cxx_patterns::match(_val,
+                               cxx_patterns::match_arm{std::tuple{counted_range<0, 0>{}, counted{}}, []()
+                                                       { return 0; }},
+                               cxx_patterns::match_arm{std::tuple{counted_range<1, 1>{}, 5}, []()
+                                                       { return 1; }},
+                               cxx_patterns::match_arm{std::tuple{counted_range<1, 9>{}, any{}}, [](const int &_y)
+                                                       { return 10 + _y; }},
+                               cxx_patterns::match_arm{std::tuple{counted_range<10, 19>{}, counted{}}, []()
+                                                       { return 2; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](const std::tuple<int, int> &)
+                                                       { return -1; }});
+}
+
+void test_match_tuple_tree_opaque_columns()
+{
+    interval_matches = 0;
+    counted_matches = 0;
+
+    cxx_tests::test_assert_expr(classify_counted({0, 3}) == 0);
+    cxx_tests::test_assert_expr(classify_counted({1, 5}) == 1);
+    cxx_tests::test_assert_expr(classify_counted({1, 6}) == 16);
+    cxx_tests::test_assert_expr(classify_counted({12, 6}) == 2);
+    cxx_tests::test_assert_expr(classify_counted({20, 6}) == -1);
+
+    // The interval columns are decided by the lookup tables, so only the opaque columns of the candidate arms are tested
+    cxx_tests::test_assert(interval_matches == 0, "interval columns tested {} times"sv, interval_matches);
+    cxx_tests::test_assert(counted_matches == 2, "opaque columns tested {} times"sv, counted_matches);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_tuple_pattern), cxx_tests::make_test(test_tuple_pattern_short_circuit), cxx_tests::make_test(test_nested_tuple_pattern),
+            cxx_tests::make_test(test_match_tuple_tree), cxx_tests::make_test(test_match_tuple_tree_opaque_columns));
@@ -0,0 +1,74 @@
+#include <match.hxx>
+#include <variant-patterns.hxx>
+
+#include "test-helper.hxx"
+
+#include <string>
+
+using namespace std::string_view_literals;
+
+using value = std::variant<int, std::string, double>;
+
+void test_alternative_pattern()
+{
+    value _val{std::string{"abc"}};
+
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::alternative<int>{}, _val));
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::alternative<std::string>{}, _val);
+    cxx_tests::test_assert_expr(_bind);
+
+    auto &&[_str] = *_bind;
+    cxx_tests::test_assert_expr(&_str == &std::get<std::string>(_val));
+}
+
+void test_alternative_subpattern()
+{
+    value _val{5};
+
+    cxx_tests::test_assert_expr(cxx_patterns::match_pattern(cxx_patterns::alternative<int, int>{5}, _val));
+    cxx_tests::test_assert_expr(!cxx_patterns::match_pattern(cxx_patterns::alternative<int, int>{6}, _val));
+
+    auto _bind = cxx_patterns::match_pattern(cxx_patterns::alternative<int, cxx_patterns::binding<int>>{{5}}, _val);
+    cxx_tests::test_assert_expr(_bind);
+    cxx_tests::test_assert_expr(&std::get<0>(*_bind) == &std::get<int>(_val));
+}
+
+int classify(const value &_val)
+{
+    return cxx_patterns::match(_val,
+                               cxx_patterns::match_arm{cxx_patterns::alternative<int, int>{0}, []()
+                                                       { return 0; }},
+                               cxx_patterns::match_arm{cxx_patterns::alternative<int>{}, [](const int &_i)
+                                                       { return _i; }},
+                               cxx_patterns::match_arm{cxx_patterns::alternative<std::string>{}, [](const std::string &_s)
+                                                       { return static_cast<int>(_s.size()) * 100; }},
+                               cxx_patterns::match_arm{cxx_patterns::binding{}, [](const value &)
+                                                       { return -1; }});
+}
+
+void test_match_variant_index()
+{
+    cxx_tests::test_assert(classify(value{0}) == 0, "match 0"sv);
+    cxx_tests::test_assert(classify(value{7}) == 7, "match 7"sv);
+    cxx_tests::test_assert(classify(value{std::string{"ab"}}) == 200, "match \"ab\""sv);
+    cxx_tests::test_assert(classify(value{1.5}) == -1, "match 1.5"sv);
+}
+
+void test_match_variant_no_copy()
+{
+    value _val{std::string{"hello"}};
+
+    cxx_patterns::match(_val,
+                        cxx_patterns::match_arm{cxx_patterns::alternative<int>{}, [](int &)
+                                                { cxx_tests::test_assert(false, "match int"sv); }},
+                        cxx_patterns::match_arm{cxx_patterns::alternative<std::string>{}, [](std::string &_s)
+                                                { _s += " world"; }},
+                        cxx_patterns::match_arm{cxx_patterns::alternative<double>{}, [](double &)
+                                                { cxx_tests::test_assert(false, "match double"sv); }});
+
+    cxx_tests::test_assert(std::get<std::string>(_val) == "hello world"sv, "modified in place"sv);
+}
+
+TEST_DRIVER(cxx_tests::make_test(test_alternative_pattern), cxx_tests::make_test(test_alternative_subpattern), cxx_tests::make_test(test_match_variant_index),
+            cxx_tests::make_test(test_match_variant_no_copy));